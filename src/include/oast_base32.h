@@ -11,6 +11,56 @@ extern const char BASE32HEX_ALPHABET[33];
 // z-base-32 alphabet
 extern const char ZBASE32_ALPHABET[33];
 
+#if defined(_MSC_VER) && !defined(__clang__)
+#define OAST_ALIGN64 __declspec(align(64))
+#else
+#define OAST_ALIGN64 __attribute__((aligned(64)))
+#endif
+
+// Character class bit flags
+#define OAST_CC_BASE32HEX  0x01 // RFC 4648 base32hex, either case
+#define OAST_CC_ZBASE32    0x02 // z-base-32, either case
+#define OAST_CC_SUBDOMAIN  0x04 // [0-9A-Za-z_-]
+#define OAST_CC_HYPHEN_US  0x08 // '-' or '_'
+#define OAST_CC_NONCE      0x10 // z-base-32 or '-'/'_' (extracted nonces)
+
+// Class flags of every byte (one 256-byte, cache-line aligned table)
+extern OAST_ALIGN64 const uint8_t OAST_CHAR_CLASS[256];
+
+static inline uint8_t oast_char_class(char c) {
+    return OAST_CHAR_CLASS[(unsigned char)c];
+}
+
+static inline bool oast_char_has(char c, uint8_t flags) {
+    return (OAST_CHAR_CLASS[(unsigned char)c] & flags) != 0;
+}
+
+// Base32hex value of every byte (either case), 0xFF if not in the alphabet
+extern const uint8_t BASE32HEX_VALUES[256];
+
+// z-base-32 value of every byte (either case), 0xFF if not in the alphabet
+extern const uint8_t ZBASE32_VALUES[256];
+
+// Decode 1-25 z-base-32 chars into a 128-bit integer (hi:lo) prefixed by a
+// sentinel 1 bit: value = (1 << 5 * len) | bits. The sentinel keeps leading
+// zero chars ('y') and the length recoverable. Returns false on a bad char
+// or length.
+bool zbase32_decode_bits(const char *input, size_t input_len,
+                         uint64_t *hi_out, uint64_t *lo_out);
+
+// Decode exactly 20 base32hex chars (an XID preamble) into its 96 bits:
+// hi = bytes 0-7, lo = bytes 8-11 (big-endian). Returns false if any char is
+// outside the alphabet. Dispatches to the kernel picked by oast_simd_init.
+bool base32hex_decode_preamble(const char *input, uint64_t *hi_out, uint32_t *lo_out);
+
+// Scalar reference decoder: table-driven and branch-free per character
+bool base32hex_decode_preamble_scalar(const char *input, uint64_t *hi_out, uint32_t *lo_out);
+
+// Encode the low 5 * n_chars bits of bits (n_chars <= 12) as lowercase
+// base32hex, most significant char first. Writes exactly n_chars bytes
+// (no terminator).
+void base32hex_encode_bits(uint64_t bits, int n_chars, char *out);
+
 // Decode base32hex string to bytes
 // Returns number of bytes decoded, or -1 on error
 int base32hex_decode(const char *input, size_t input_len, uint8_t *output, size_t *output_len);
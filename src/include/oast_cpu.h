@@ -0,0 +1,68 @@
+#ifndef OAST_CPU_H
+#define OAST_CPU_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+// x86 SIMD availability at compile time. SSE2 is part of the x86-64
+// baseline; SSE4.1 and AVX2 kernels are compiled with a per-function target
+// attribute (GCC/Clang) or unconditionally (MSVC) and only called after a
+// runtime check.
+#if defined(__x86_64__) || defined(_M_X64) ||                                 \
+    (defined(__i386__) && defined(__SSE2__))
+#define OAST_HAVE_SSE2 1
+#if defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER)
+#define OAST_HAVE_SSE41 1
+#define OAST_HAVE_AVX2 1
+#endif
+#endif
+
+#if defined(OAST_HAVE_AVX2) && (defined(__GNUC__) || defined(__clang__))
+#define OAST_TARGET_SSE41 __attribute__((target("ssse3,sse4.1")))
+#define OAST_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define OAST_TARGET_SSE41
+#define OAST_TARGET_AVX2
+#endif
+
+// Kernel families, in increasing order of capability
+typedef enum {
+    OAST_KERNEL_SCALAR,
+    OAST_KERNEL_SSE41,
+    OAST_KERNEL_AVX2
+} oast_kernel_level_t;
+
+// Runtime CPU feature checks (false on non-x86 targets)
+bool oast_cpu_has_sse41(void);
+bool oast_cpu_has_avx2(void);
+
+// Best kernel family this CPU supports
+oast_kernel_level_t oast_cpu_best_level(void);
+
+// Index of the lowest set bit (mask must be non-zero)
+static inline unsigned oast_ctz32(uint32_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long idx;
+  _BitScanForward(&idx, mask);
+  return (unsigned)idx;
+#else
+  return (unsigned)__builtin_ctz(mask);
+#endif
+}
+
+// Number of set bits
+static inline unsigned oast_popcount32(uint32_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+  mask = mask - ((mask >> 1) & 0x55555555u);
+  mask = (mask & 0x33333333u) + ((mask >> 2) & 0x33333333u);
+  return (((mask + (mask >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24;
+#else
+  return (unsigned)__builtin_popcount(mask);
+#endif
+}
+
+#endif // OAST_CPU_H
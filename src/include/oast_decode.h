@@ -1,6 +1,7 @@
 #ifndef OAST_DECODE_H
 #define OAST_DECODE_H
 
+#include "oast_shape.h"
 #include <stdint.h>
 #include <stdbool.h>
 #include <stddef.h>
@@ -16,11 +17,151 @@ typedef struct {
     char     ksort[7];        // First 6 chars of preamble for K-sorting + null
     char     campaign[6];     // Chars 7-11 of preamble (campaign ID) + null
     bool     valid;           // Whether decode succeeded
-    char     error[256];      // Error message if invalid
+    uint8_t  error_code;      // oast_decode_status_t (0 when valid)
 } oast_decoded_t;
 
 // Decode an OAST domain (subdomain or FQDN)
 // Returns 0 on success, -1 on failure
 int oast_decode(const char *input, size_t input_len, oast_decoded_t *result);
 
+// Raw 96-bit XID from a decoded preamble: hi = bytes 0-7, lo = bytes 8-11
+typedef struct {
+    uint64_t hi;
+    uint32_t lo;
+} oast_xid_t;
+
+// Outcome of a decode. The values are stable: they are exposed in SQL as
+// the error_code field of oast_decode() and oast_extract_structs().
+typedef enum {
+    OAST_DECODE_OK = 0,
+    OAST_DECODE_EMPTY,          // Empty input
+    OAST_DECODE_TOO_LONG,       // Subdomain longer than OAST_MAX_SUBDOMAIN
+    OAST_DECODE_TOO_SHORT,      // Subdomain shorter than the correlation id
+    OAST_DECODE_BAD_PREAMBLE,   // Preamble has non-base32hex characters
+    OAST_DECODE_STATUS_COUNT
+} oast_decode_status_t;
+
+// Static message for a status code, NULL for OAST_DECODE_OK and unknown codes
+const char *oast_decode_error_message(unsigned code);
+
+#define OAST_MAX_SUBDOMAIN 255
+
+// Compact, zero-copy decode result (24 bytes). Strings are not copied:
+// the subdomain is input[0, subdomain_len) and the nonce is
+// input[nonce_off, nonce_off + nonce_len) of the caller's input, in the
+// caller's case. xid is only meaningful when status == OAST_DECODE_OK.
+typedef struct {
+    oast_xid_t xid;
+    uint16_t   subdomain_len;
+    uint16_t   nonce_off;
+    uint16_t   nonce_len;
+    uint8_t    status;        // oast_decode_status_t
+} oast_decode_view_t;
+
+// Decode an OAST domain (subdomain or FQDN) into a view over input.
+// Same acceptance rules as oast_decode; returns view->status.
+oast_decode_status_t oast_decode_view(const char *input, size_t input_len,
+                                      oast_decode_view_t *view);
+
+// oast_decode_view for a correlation id of shape.cid_len chars (nonce_len is
+// not checked). A truncated id decodes as if padded with '0' to 20 chars, so
+// only XID fields within its first cid_len chars are meaningful (see
+// OAST_CID_CHARS_*). The nonce starts at nonce_off == cid_len.
+oast_decode_status_t oast_decode_view_shape(const char *input,
+                                            size_t input_len,
+                                            oast_shape_t shape,
+                                            oast_decode_view_t *view);
+
+// Decode a correlation id of cid_len (1..OAST_MAX_CID_LEN) base32hex chars
+// into the XID it was truncated from, reading missing trailing chars as '0'
+// Returns false if the id holds a non-base32hex char
+bool oast_decode_cid(const char *cid, size_t cid_len, oast_xid_t *xid);
+
+// Decode only the 20-char preamble at the start of input into the raw XID
+// (no nonce handling, no copies)
+// Returns 0 on success, -1 if input does not start with a valid preamble
+int oast_decode_preamble(const char *input, size_t input_len, oast_xid_t *xid);
+
+// Column outputs of oast_decode_batch: element i of each array receives the
+// field of domain i. Any pointer may be NULL to skip that field. Types match
+// the DuckDB vectors they are meant to back (BIGINT, INTEGER, ...).
+// Undecodable domains get 0 in every numeric field.
+typedef struct {
+    int64_t  *ts;          // Unix seconds
+    uint32_t *machine_id;  // 24-bit machine ID
+    int32_t  *pid;
+    int32_t  *counter;     // 24-bit counter
+    bool     *valid;
+    uint8_t  *status;      // oast_decode_status_t
+    uint16_t *nonce_len;   // Nonce is ptrs[i][cid, cid + nonce_len)
+} oast_decode_columns_t;
+
+// Fill the XID columns of out (ts, machine_id, pid, counter) from n XIDs
+// (hi[i]:lo[i], see oast_xid_t) decoded elsewhere, e.g. during extraction.
+// valid, status and nonce_len are left to the caller.
+void oast_decode_xid_columns(const uint64_t *hi, const uint32_t *lo,
+                             size_t n, const oast_decode_columns_t *out);
+
+// Rows decoded per internal block of oast_decode_batch
+#define OAST_DECODE_BATCH_BLOCK 256
+
+// Decode n domains (structure-of-arrays). Each block first decodes the raw
+// XIDs, then extracts every requested field in its own tight loop over
+// contiguous arrays, which the compiler can vectorize.
+void oast_decode_batch(const char **ptrs, const size_t *lens, size_t n,
+                       const oast_decode_columns_t *out);
+
+// oast_decode_batch with oast_decode_view_shape semantics
+void oast_decode_batch_shape(const char **ptrs, const size_t *lens, size_t n,
+                             oast_shape_t shape,
+                             const oast_decode_columns_t *out);
+
+// Longest nonce that oast_decode_nonce_int can represent (125 bits + sentinel)
+#define OAST_NONCE_INT_MAX_CHARS 25
+
+// Decode the z-base-32 nonce of a domain (subdomain or FQDN) into a 128-bit
+// integer hi:lo, see zbase32_decode_bits. Returns 0 on success, -1 if the
+// domain does not decode or the nonce is empty, too long or not z-base-32
+int oast_decode_nonce_int(const char *input, size_t input_len, uint64_t *hi,
+                          uint64_t *lo);
+
+// Decode only the XID timestamp from the first 7 base32hex chars of input
+// (35 bits; the timestamp is the top 32). Checks nothing past char 7.
+// Returns 0 on success, -1 if input is shorter than 7 or has a bad char
+int oast_decode_ts_prefix(const char *input, size_t input_len, uint32_t *ts);
+
+// Chars of the preamble that carry the timestamp (35 bits: ts + 3 bits of
+// machine ID)
+#define OAST_TS_PREFIX_LEN 7
+
+// Lexicographic bounds covering every lowercase domain whose timestamp is in
+// [ts_lo, ts_hi]: lo is the 7-char prefix of ts_lo with the low bits clear,
+// hi is the 7-char prefix of ts_hi with the low bits set, followed by '~'
+// (above every subdomain char). Base32hex preserves byte order, so
+// lo <= domain <= hi exactly when the timestamp is in range.
+void oast_ts_prefix_bounds(uint32_t ts_lo, uint32_t ts_hi,
+                           char lo[OAST_TS_PREFIX_LEN],
+                           char hi[OAST_TS_PREFIX_LEN + 1]);
+
+// XID field accessors
+// Bytes 0-3: timestamp (big-endian uint32)
+static inline uint32_t oast_xid_timestamp(const oast_xid_t *xid) {
+    return (uint32_t)(xid->hi >> 32);
+}
+
+// Bytes 4-6: machine ID (24-bit big-endian)
+static inline uint32_t oast_xid_machine_id(const oast_xid_t *xid) {
+    return (uint32_t)(xid->hi >> 8) & 0xFFFFFF;
+}
+
+// Bytes 7-8: PID (big-endian uint16)
+static inline uint16_t oast_xid_pid(const oast_xid_t *xid) {
+    return (uint16_t)(((xid->hi & 0xFF) << 8) | (xid->lo >> 24));
+}
+
+// Bytes 9-11: counter (24-bit big-endian)
+static inline uint32_t oast_xid_counter(const oast_xid_t *xid) {
+    return xid->lo & 0xFFFFFF;
+}
+
 #endif // OAST_DECODE_H
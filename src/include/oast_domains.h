@@ -7,11 +7,26 @@
 // Known OAST domain suffixes (null-terminated array)
 extern const char *KNOWN_OAST_DOMAINS[];
 
+// Build the suffix lookup table (perfect hash over the last labels of a
+// domain, one key per label count a suffix has, with precomputed lengths).
+// Must be called once (at extension load, via oast_extract_init) before any
+// lookup; idempotent. Returns false if the list has more than 32 suffixes,
+// a suffix has more than 8 labels, or no collision-free seed is found.
+bool oast_domains_init(void);
+
+// Index into KNOWN_OAST_DOMAINS of the suffix domain ends with (at the start
+// of domain or after a dot), or -1. Cost is bounded by the longest suffix,
+// not the number of suffixes.
+int oast_match_suffix(const char *domain, size_t domain_len);
+
+// Precomputed strlen of KNOWN_OAST_DOMAINS[index]
+size_t oast_suffix_len(int index);
+
 // Check if a domain ends with a known OAST suffix
 // Returns the matching suffix or NULL if not an OAST domain
 const char *is_known_oast_domain(const char *domain, size_t domain_len);
 
-// Get the subdomain portion of a full OAST domain
+// Get the subdomain portion of a full OAST domain (one suffix lookup)
 // Returns length of subdomain, or 0 if not valid
 size_t get_oast_subdomain(const char *full, size_t full_len, const char **subdomain_out);
 
@@ -0,0 +1,18 @@
+#ifndef OAST_ENCODE_H
+#define OAST_ENCODE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Encode XID fields as the 20-char lowercase base32hex preamble (inverse of
+// oast_decode_preamble). machine_id and counter use their low 24 bits.
+void oast_encode_preamble(uint32_t ts, uint32_t machine_id, uint16_t pid,
+                          uint32_t counter, char out[20]);
+
+// Encode a sentinel-prefixed nonce integer (see zbase32_decode_bits) as
+// lowercase z-base-32. Returns the number of chars written (1-25), or 0 if
+// hi:lo has no valid sentinel.
+size_t oast_encode_nonce_int(uint64_t hi, uint64_t lo, char *out);
+
+#endif // OAST_ENCODE_H
@@ -1,7 +1,13 @@
 #ifndef OAST_EXTRACT_H
 #define OAST_EXTRACT_H
 
+#include "oast_decode.h"
+#include "oast_domains.h"
+#include "oast_shape.h"
+#include "oast_validate.h"
+#include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 // Extracted OAST domain match
 typedef struct {
@@ -14,9 +20,138 @@ typedef struct {
     size_t      end_idx;
 } oast_match_t;
 
-// Extract all OAST domains from text
-// Caller must free the returned matches array with free()
+// Compact extracted match: offsets into the source text (not owned) and the
+// matched suffix. DuckDB strings are shorter than 4 GiB, so 32-bit offsets
+// are enough.
+typedef struct {
+    uint32_t start;     // Start of the subdomain
+    uint32_t len;       // Length of subdomain.suffix
+    uint16_t suffix_id; // Index into KNOWN_OAST_DOMAINS
+} oast_span_t;
+
+// Length of the subdomain (the label before the suffix) of span
+static inline size_t oast_span_subdomain_len(const oast_span_t *span) {
+    return span->len - oast_suffix_len(span->suffix_id) - 1;
+}
+
+// Spans an arena holds before it first allocates
+#define OAST_SPAN_ARENA_INLINE 256
+
+// Reusable span buffer, e.g. one per DuckDB chunk. Spans are appended in
+// text order; the first OAST_SPAN_ARENA_INLINE are stored inline, beyond
+// that the buffer grows geometrically on the heap and is kept across
+// resets. A decoding arena also holds the XID of every span, decoded from
+// the correlation id as soon as the match is found, while its bytes are
+// still in cache; it always reads as status OAST_DECODE_OK, because the
+// extractor has already checked the shape. spans and xids may point into
+// the arena itself, so never copy one.
+typedef struct {
+    oast_span_t *spans;
+    oast_xid_t  *xids;        // Parallel to spans in a decoding arena, else NULL
+    size_t       count;
+    size_t       capacity;
+    oast_span_t  inline_spans[OAST_SPAN_ARENA_INLINE];
+    oast_xid_t   inline_xids[OAST_SPAN_ARENA_INLINE];
+} oast_span_arena_t;
+
+void oast_span_arena_init(oast_span_arena_t *arena);
+
+// Initialize an arena that decodes spans as they are extracted (fused
+// extract + decode)
+void oast_span_arena_init_decoding(oast_span_arena_t *arena);
+
+// Drop all spans, keeping the memory
+static inline void oast_span_arena_reset(oast_span_arena_t *arena) {
+    arena->count = 0;
+}
+
+// Release heap memory and drop all spans; the arena stays usable
+void oast_span_arena_free(oast_span_arena_t *arena);
+
+// Longest DNS label. A subdomain is one label, so longer runs of subdomain
+// chars are never matched; this also bounds the work per candidate.
+#define OAST_MAX_LABEL 63
+
+// Candidate scan kernels. The SIMD kernels only visit positions where a '.'
+// is followed by the first byte of a known suffix.
+typedef enum {
+    OAST_SCAN_SCALAR,
+    OAST_SCAN_SSE2,
+    OAST_SCAN_AVX2
+} oast_scan_kernel_t;
+
+// Build the suffix automaton from KNOWN_OAST_DOMAINS. Must be called once
+// (at extension load) before any extraction function; idempotent. Returns
+// false if the suffix list does not fit the automaton's or the suffix
+// lookup's fixed tables.
+bool oast_extract_init(void);
+
+// Override the scan kernel picked by oast_extract_init (benchmarks, tests)
+// Returns false if the kernel is not available on this build/CPU
+bool oast_extract_set_kernel(oast_scan_kernel_t kernel);
+oast_scan_kernel_t oast_extract_get_kernel(void);
+
+// Append every OAST domain in text to arena, in text order; *appended_out
+// gets the number added. Nothing is allocated unless the arena outgrows its
+// buffer. Returns 0 on success, -1 on allocation failure or if text is 4 GiB
+// or longer (spans added before a failure are kept).
+int oast_extract_spans(const char *text, size_t text_len, oast_shape_t shape,
+                       oast_span_arena_t *arena, size_t *appended_out);
+
+// Words of the suffix filter bitset (suffix ids below 64 * this)
+#define OAST_SUFFIX_MASK_WORDS 4
+
+// Options for oast_extract_spans_opts. Zero-initialized means no options.
+typedef struct {
+    size_t   max_matches;     // Stop scanning after this many matches (0 = all)
+    bool     dedup;           // Drop repeats of a domain (case-insensitive)
+    bool     filter_suffixes; // Only match suffixes set in suffix_mask
+    uint64_t suffix_mask[OAST_SUFFIX_MASK_WORDS]; // Bit per suffix id
+} oast_extract_opts_t;
+
+// Allow the known suffix name (case-insensitive) in opts' filter, turning
+// the filter on. Returns false if name is not a known OAST suffix.
+bool oast_extract_opts_allow_suffix(oast_extract_opts_t *opts,
+                                    const char *name, size_t name_len);
+
+// oast_extract_spans with options (NULL = none). Repeats dropped by dedup
+// do not count towards max_matches; scanning stops as soon as max_matches
+// are found, so the rest of the text is never read.
+int oast_extract_spans_opts(const char *text, size_t text_len,
+                            oast_shape_t shape,
+                            const oast_extract_opts_t *opts,
+                            oast_span_arena_t *arena, size_t *appended_out);
+
+// Extract all OAST domains from text (in text order) as full matches
+// Caller must free the returned matches array with free(); prefer
+// oast_extract_spans on hot paths
 // Returns number of matches found, or -1 on error
 int oast_extract(const char *text, size_t text_len, oast_match_t **matches_out, size_t *match_count_out);
 
+// oast_extract for subdomains of a non-default shape
+int oast_extract_shape(const char *text, size_t text_len, oast_shape_t shape,
+                       oast_match_t **matches_out, size_t *match_count_out);
+
+// Count OAST domains in text without recording spans or allocating
+// Stops scanning once limit matches are found (0 = no limit)
+size_t oast_count_matches(const char *text, size_t text_len, size_t limit);
+
+// oast_count_matches for subdomains of a non-default shape
+size_t oast_count_matches_shape(const char *text, size_t text_len,
+                                oast_shape_t shape, size_t limit);
+
+// Subdomain check the extractor applies to candidates of shape (a
+// fixed-width kernel for OAST_SHAPE_KERNELS pairs). Like the validator, but
+// the nonce may also hold '-' and '_'.
+oast_subdomain_fn oast_extract_kernel(oast_shape_t shape);
+
+// oast_count_matches_shape with check already resolved by
+// oast_extract_kernel(shape), for callers that count many texts of one shape
+size_t oast_count_matches_kernel(const char *text, size_t text_len,
+                                 oast_shape_t shape, oast_subdomain_fn check,
+                                 size_t limit);
+
+// Check if text contains at least one OAST domain (stops at the first match)
+bool oast_has_match(const char *text, size_t text_len);
+
 #endif // OAST_EXTRACT_H
@@ -0,0 +1,73 @@
+#ifndef OAST_SHAPE_H
+#define OAST_SHAPE_H
+
+#include "oast_base32.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Subdomain shape: a base32hex correlation id of cid_len chars followed by a
+// nonce of at least nonce_len chars. interactsh sets these with -cidl and
+// -cidn; the correlation id is an XID truncated to cid_len, so it is never
+// longer than the 20-char XID.
+typedef struct {
+    uint8_t cid_len;
+    uint8_t nonce_len;
+} oast_shape_t;
+
+#define OAST_CID_LEN       20 // interactsh default, full XID
+#define OAST_NONCE_LEN     13 // interactsh default
+#define OAST_MAX_CID_LEN   20
+
+#define OAST_SHAPE_DEFAULT ((oast_shape_t){OAST_CID_LEN, OAST_NONCE_LEN})
+
+// Preamble chars an XID field needs to be fully present in a truncated
+// correlation id (5 bits per char)
+#define OAST_CID_CHARS_TS         7
+#define OAST_CID_CHARS_MACHINE_ID 12
+#define OAST_CID_CHARS_PID        15
+#define OAST_CID_CHARS_COUNTER    20
+#define OAST_CID_CHARS_KSORT      6
+#define OAST_CID_CHARS_CAMPAIGN   11
+
+static inline bool oast_shape_is_default(oast_shape_t shape) {
+    return shape.cid_len == OAST_CID_LEN && shape.nonce_len == OAST_NONCE_LEN;
+}
+
+// True if cid_len is 1..OAST_MAX_CID_LEN (any nonce_len is accepted)
+static inline bool oast_shape_is_valid(oast_shape_t shape) {
+    return shape.cid_len >= 1 && shape.cid_len <= OAST_MAX_CID_LEN;
+}
+
+// (cid_len, nonce_len) pairs that get fixed-width kernels, instantiated with
+// X(cid_len, nonce_len). Every other valid shape uses the generic loop.
+#define OAST_SHAPE_KERNELS(X) \
+    X(20, 13)                 \
+    X(20, 8)                  \
+    X(20, 16)                 \
+    X(16, 13)                 \
+    X(12, 13)
+
+// Shared body of the shape kernels: cid_len base32hex chars, then at least
+// nonce_len chars of nonce_class. Called with constant lengths the loops are
+// fully unrolled / vectorized by the compiler.
+static inline bool oast_shape_match(const char *s, size_t len, size_t cid_len,
+                                    size_t nonce_len, uint8_t nonce_class) {
+    if (len < cid_len + nonce_len) {
+        return false;
+    }
+
+    // AND the class flags of every char; no early exit per character
+    uint8_t preamble = 0xFF;
+    for (size_t i = 0; i < cid_len; i++) {
+        preamble &= oast_char_class(s[i]);
+    }
+    uint8_t nonce = 0xFF;
+    for (size_t i = cid_len; i < len; i++) {
+        nonce &= oast_char_class(s[i]);
+    }
+
+    return (preamble & OAST_CC_BASE32HEX) && (nonce & nonce_class);
+}
+
+#endif // OAST_SHAPE_H
@@ -0,0 +1,34 @@
+#ifndef OAST_SIMD_H
+#define OAST_SIMD_H
+
+#include "oast_cpu.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Runtime-dispatched kernels for the per-domain hot paths (subdomain shape
+// validation and preamble decode). The scalar table-driven versions are the
+// reference; SSE4.1 and AVX2 versions must return identical results.
+typedef bool (*oast_valid_subdomain_fn)(const char *s, size_t len);
+typedef bool (*oast_decode_preamble_fn)(const char *input, uint64_t *hi_out,
+                                        uint32_t *lo_out);
+
+// Active kernels (scalar until oast_simd_init runs)
+extern oast_valid_subdomain_fn oast_simd_valid_subdomain;
+extern oast_decode_preamble_fn oast_simd_decode_preamble;
+
+// Pick the best kernels for this CPU (CPUID), including the extraction scan
+// kernel. Called once at extension load, after oast_extract_init.
+void oast_simd_init(void);
+
+// Force a kernel family (benchmarks, tests). Returns false, leaving the
+// active kernels unchanged, if the CPU or build does not support it.
+bool oast_simd_set_level(oast_kernel_level_t level);
+
+oast_kernel_level_t oast_simd_get_level(void);
+
+// "scalar", "sse4.1" or "avx2"
+const char *oast_simd_level_name(oast_kernel_level_t level);
+
+#endif // OAST_SIMD_H
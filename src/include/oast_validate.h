@@ -1,17 +1,86 @@
 #ifndef OAST_VALIDATE_H
 #define OAST_VALIDATE_H
 
+#include "oast_shape.h"
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
-// Validate that a string is a valid OAST subdomain
-// (20+ base32hex chars + 13 z-base-32 chars)
+// Validate that a string is a valid OAST subdomain in the default shape
+// (20 base32hex chars + 13 or more z-base-32 chars)
+// Dispatches to the kernel picked by oast_simd_init
 bool oast_is_valid_subdomain(const char *s, size_t len);
 
+// Scalar reference implementation of oast_is_valid_subdomain
+bool oast_is_valid_subdomain_scalar(const char *s, size_t len);
+
 // Validate that a 20-char string is valid base32hex preamble
 bool oast_is_valid_preamble(const char *s, size_t len);
 
 // Validate that a string is a valid OAST domain (subdomain or FQDN)
 bool oast_validate(const char *input, size_t input_len);
 
+// Subdomain validator for a shape; fixed-width kernels ignore shape
+typedef bool (*oast_subdomain_fn)(const char *s, size_t len,
+                                  oast_shape_t shape);
+
+// Pick the validator for shape: the dispatched SIMD kernel for the default
+// shape, a fixed-width kernel for OAST_SHAPE_KERNELS pairs, otherwise
+// oast_is_valid_subdomain_shape. Resolve once per batch, not per row.
+oast_subdomain_fn oast_subdomain_kernel(oast_shape_t shape);
+
+// Generic validator for any shape (cid_len base32hex chars, then at least
+// nonce_len z-base-32 chars)
+bool oast_is_valid_subdomain_shape(const char *s, size_t len,
+                                   oast_shape_t shape);
+
+// oast_validate for a non-default shape, with a kernel from
+// oast_subdomain_kernel(shape)
+bool oast_validate_shape(const char *input, size_t input_len,
+                         oast_subdomain_fn kernel, oast_shape_t shape);
+
+// Validation levels, cheapest first. Each level has its own kernel so a
+// cheap level can filter at ingest and a costly one run on survivors.
+typedef enum {
+    OAST_LEVEL_SHAPE,      // Known suffix and subdomain length only
+    OAST_LEVEL_STRICT,     // + character classes (oast_validate)
+    OAST_LEVEL_PLAUSIBLE,  // + timestamp bounds, counter, nonce entropy
+    OAST_LEVEL_COUNT
+} oast_validate_level_t;
+
+// Parse "shape", "strict" or "plausible" (any case). Returns false if s
+// names no level.
+bool oast_validate_level_parse(const char *s, size_t len,
+                               oast_validate_level_t *level);
+
+// Earliest XID timestamp the plausible level accepts (2021-01-01, before
+// the first interactsh release)
+#define OAST_PLAUSIBLE_TS_MIN 1609459200u
+
+// Slack allowed for timestamps ahead of the caller's clock
+#define OAST_PLAUSIBLE_TS_SKEW 86400u
+
+// State for the level kernels, resolved once per batch
+typedef struct {
+    oast_shape_t      shape;
+    oast_subdomain_fn subdomain; // oast_subdomain_kernel(shape)
+    uint32_t          ts_min;    // Plausible timestamp window (inclusive)
+    uint32_t          ts_max;
+} oast_validate_ctx_t;
+
+// Fill ctx for shape; now (Unix seconds) bounds plausible timestamps
+void oast_validate_ctx_init(oast_validate_ctx_t *ctx, oast_shape_t shape,
+                            uint32_t now);
+
+typedef bool (*oast_level_fn)(const char *input, size_t input_len,
+                              const oast_validate_ctx_t *ctx);
+
+// Kernel for a validation level (NULL for an unknown level)
+oast_level_fn oast_level_kernel(oast_validate_level_t level);
+
+// The shape level without a context: one suffix lookup and a length check,
+// no per-char work
+bool oast_validate_level_shape(const char *input, size_t input_len,
+                               oast_shape_t shape);
+
 #endif // OAST_VALIDATE_H
@@ -1,6 +1,5 @@
 #include "oast_base32.h"
-#include <ctype.h>
-#include <string.h>
+#include "oast_simd.h"
 
 // Base32hex alphabet (RFC 4648, lowercase)
 const char BASE32HEX_ALPHABET[33] = "0123456789abcdefghijklmnopqrstuv";
@@ -8,26 +7,106 @@ const char BASE32HEX_ALPHABET[33] = "0123456789abcdefghijklmnopqrstuv";
 // z-base-32 alphabet
 const char ZBASE32_ALPHABET[33] = "ybndrfg8ejkmcpqxot1uwisza345h769";
 
+// Character classes of every byte (see OAST_CC_* in oast_base32.h).
+// Both cases of a letter share flags; bytes >= 0x80 have none.
+OAST_ALIGN64 const uint8_t OAST_CHAR_CLASS[256] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1C, 0x00, 0x00,
+    0x05, 0x17, 0x05, 0x17, 0x17, 0x17, 0x17, 0x17, 0x17, 0x17, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x17, 0x17, 0x17, 0x17, 0x17, 0x17, 0x17, 0x17, 0x17, 0x17, 0x17, 0x05, 0x17, 0x17, 0x17,
+    0x17, 0x17, 0x17, 0x17, 0x17, 0x17, 0x05, 0x16, 0x16, 0x16, 0x16, 0x00, 0x00, 0x00, 0x00, 0x1C,
+    0x00, 0x17, 0x17, 0x17, 0x17, 0x17, 0x17, 0x17, 0x17, 0x17, 0x17, 0x17, 0x05, 0x17, 0x17, 0x17,
+    0x17, 0x17, 0x17, 0x17, 0x17, 0x17, 0x05, 0x16, 0x16, 0x16, 0x16, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
 bool is_base32hex_char(char c) {
-  return strchr(BASE32HEX_ALPHABET, tolower(c)) != NULL;
+  return oast_char_has(c, OAST_CC_BASE32HEX);
 }
 
-bool is_zbase32_char(char c) {
-  return strchr(ZBASE32_ALPHABET, tolower(c)) != NULL;
+bool is_zbase32_char(char c) { return oast_char_has(c, OAST_CC_ZBASE32); }
+
+// Base32hex value of every byte (either case); 0xFF marks bytes outside the
+// alphabet so an OR over all looked-up values exposes any invalid char.
+const uint8_t BASE32HEX_VALUES[256] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18,
+    0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18,
+    0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
+// z-base-32 value of every byte (either case); 0xFF outside the alphabet
+const uint8_t ZBASE32_VALUES[256] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x12, 0xFF, 0x19, 0x1A, 0x1B, 0x1E, 0x1D, 0x07, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x18, 0x01, 0x0C, 0x03, 0x08, 0x05, 0x06, 0x1C, 0x15, 0x09, 0x0A, 0xFF, 0x0B, 0x02, 0x10,
+    0x0D, 0x0E, 0x04, 0x16, 0x11, 0x13, 0xFF, 0x14, 0x0F, 0x00, 0x17, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x18, 0x01, 0x0C, 0x03, 0x08, 0x05, 0x06, 0x1C, 0x15, 0x09, 0x0A, 0xFF, 0x0B, 0x02, 0x10,
+    0x0D, 0x0E, 0x04, 0x16, 0x11, 0x13, 0xFF, 0x14, 0x0F, 0x00, 0x17, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
+bool base32hex_decode_preamble(const char *input, uint64_t *hi_out,
+                               uint32_t *lo_out) {
+  return oast_simd_decode_preamble(input, hi_out, lo_out);
 }
 
-// Get base32hex character value (0-31), or -1 if invalid
-static int base32hex_char_value(char c) {
-  if (c >= '0' && c <= '9') {
-    return c - '0';
-  }
-  if (c >= 'a' && c <= 'v') {
-    return c - 'a' + 10;
+bool base32hex_decode_preamble_scalar(const char *input, uint64_t *hi_out,
+                                      uint32_t *lo_out) {
+  const unsigned char *s = (const unsigned char *)input;
+
+  // Fixed shape: chars 0-11 -> 60 bits, chars 12-19 -> 40 bits. No early
+  // exits; validity is checked once on the OR of every value.
+  uint64_t a = 0;
+  uint64_t b = 0;
+  uint8_t check = 0;
+
+  for (int i = 0; i < 12; i++) {
+    uint8_t v = BASE32HEX_VALUES[s[i]];
+    check |= v;
+    a = (a << 5) | v;
   }
-  if (c >= 'A' && c <= 'V') {
-    return c - 'A' + 10;
+  for (int i = 12; i < 20; i++) {
+    uint8_t v = BASE32HEX_VALUES[s[i]];
+    check |= v;
+    b = (b << 5) | v;
   }
-  return -1;
+
+  // The 100 bits are a:b; the XID is the top 96 bits (the last 4 bits are
+  // padding). hi = XID bytes 0-7, lo = XID bytes 8-11.
+  *hi_out = (a << 4) | (b >> 36);
+  *lo_out = (uint32_t)(b >> 4);
+
+  return (check & 0xE0) == 0;
 }
 
 int base32hex_decode(const char *input, size_t input_len, uint8_t *output,
@@ -35,34 +114,52 @@ int base32hex_decode(const char *input, size_t input_len, uint8_t *output,
   // Base32hex: 5 bits per character
   // 20 chars × 5 bits = 100 bits = 12.5 bytes, use 12 bytes
 
-  if (input_len != 20) {
+  uint64_t hi;
+  uint32_t lo;
+
+  if (input_len != 20 || !base32hex_decode_preamble(input, &hi, &lo)) {
     *output_len = 0;
     return -1;
   }
 
-  uint64_t bit_buffer = 0;
-  int bit_count = 0;
-  size_t byte_index = 0;
+  for (int i = 0; i < 8; i++) {
+    output[i] = (uint8_t)(hi >> (56 - 8 * i));
+  }
+  for (int i = 0; i < 4; i++) {
+    output[8 + i] = (uint8_t)(lo >> (24 - 8 * i));
+  }
+
+  *output_len = 12;
+  return 0;
+}
 
+void base32hex_encode_bits(uint64_t bits, int n_chars, char *out) {
+  for (int i = n_chars - 1; i >= 0; i--) {
+    out[i] = BASE32HEX_ALPHABET[bits & 0x1F];
+    bits >>= 5;
+  }
+}
+
+bool zbase32_decode_bits(const char *input, size_t input_len,
+                         uint64_t *hi_out, uint64_t *lo_out) {
+  if (input_len == 0 || input_len > 25) {
+    return false;
+  }
+
+  const unsigned char *s = (const unsigned char *)input;
+
+  // Start from the sentinel bit; each char shifts 5 bits across the pair
+  uint64_t hi = 0;
+  uint64_t lo = 1;
+  uint8_t check = 0;
   for (size_t i = 0; i < input_len; i++) {
-    int val = base32hex_char_value(input[i]);
-    if (val < 0) {
-      *output_len = 0;
-      return -1; // Invalid character
-    }
-
-    // Add 5 bits to buffer
-    bit_buffer = (bit_buffer << 5) | (uint64_t)val;
-    bit_count += 5;
-
-    // Extract complete bytes
-    while (bit_count >= 8 && byte_index < 12) {
-      bit_count -= 8;
-      output[byte_index] = (uint8_t)((bit_buffer >> bit_count) & 0xFF);
-      byte_index++;
-    }
+    uint8_t v = ZBASE32_VALUES[s[i]];
+    check |= v;
+    hi = (hi << 5) | (lo >> 59);
+    lo = (lo << 5) | (v & 0x1F);
   }
 
-  *output_len = byte_index;
-  return 0;
+  *hi_out = hi;
+  *lo_out = lo;
+  return (check & 0xE0) == 0;
 }
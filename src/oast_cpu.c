@@ -0,0 +1,63 @@
+#include "oast_cpu.h"
+
+#if defined(OAST_HAVE_AVX2) && defined(_MSC_VER) && !defined(__clang__)
+// CPUID leaf 1 ECX / leaf 7 EBX feature bits
+#define CPUID_1_ECX_SSSE3 (1 << 9)
+#define CPUID_1_ECX_SSE41 (1 << 19)
+#define CPUID_1_ECX_OSXSAVE (1 << 27)
+#define CPUID_1_ECX_AVX (1 << 28)
+#define CPUID_7_EBX_AVX2 (1 << 5)
+
+static int cpuid_ecx1(void) {
+  int regs[4];
+  __cpuid(regs, 1);
+  return regs[2];
+}
+#endif
+
+bool oast_cpu_has_sse41(void) {
+#if !defined(OAST_HAVE_SSE41)
+  return false;
+#elif defined(_MSC_VER) && !defined(__clang__)
+  int ecx = cpuid_ecx1();
+  return (ecx & CPUID_1_ECX_SSSE3) && (ecx & CPUID_1_ECX_SSE41);
+#else
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("ssse3") && __builtin_cpu_supports("sse4.1");
+#endif
+}
+
+bool oast_cpu_has_avx2(void) {
+#if !defined(OAST_HAVE_AVX2)
+  return false;
+#elif defined(_MSC_VER) && !defined(__clang__)
+  int regs[4];
+  __cpuid(regs, 0);
+  if (regs[0] < 7) {
+    return false;
+  }
+  // OSXSAVE + AVX, and the OS must save YMM state
+  int ecx = cpuid_ecx1();
+  if (!(ecx & CPUID_1_ECX_OSXSAVE) || !(ecx & CPUID_1_ECX_AVX)) {
+    return false;
+  }
+  if ((_xgetbv(0) & 0x6) != 0x6) {
+    return false;
+  }
+  __cpuidex(regs, 7, 0);
+  return (regs[1] & CPUID_7_EBX_AVX2) != 0;
+#else
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+#endif
+}
+
+oast_kernel_level_t oast_cpu_best_level(void) {
+  if (oast_cpu_has_avx2() && oast_cpu_has_sse41()) {
+    return OAST_KERNEL_AVX2;
+  }
+  if (oast_cpu_has_sse41()) {
+    return OAST_KERNEL_SSE41;
+  }
+  return OAST_KERNEL_SCALAR;
+}
@@ -3,124 +3,258 @@
 #include "oast_domains.h"
 #include "oast_validate.h"
 #include <ctype.h>
-#include <stdio.h>
 #include <string.h>
 
-// Read big-endian uint32 from bytes
-static uint32_t read_be32(const uint8_t *bytes) {
-  return ((uint32_t)bytes[0] << 24) | ((uint32_t)bytes[1] << 16) |
-         ((uint32_t)bytes[2] << 8) | ((uint32_t)bytes[3]);
+int oast_decode_preamble(const char *input, size_t input_len,
+                         oast_xid_t *xid) {
+  if (input_len < 20) {
+    return -1;
+  }
+
+  // The decode table rejects any non-alphabet character, which also
+  // guarantees there is no dot inside the first 20 chars
+  if (!base32hex_decode_preamble(input, &xid->hi, &xid->lo)) {
+    return -1;
+  }
+  return 0;
 }
 
-// Read big-endian uint16 from bytes
-static uint16_t read_be16(const uint8_t *bytes) {
-  return ((uint16_t)bytes[0] << 8) | ((uint16_t)bytes[1]);
+int oast_decode_ts_prefix(const char *input, size_t input_len, uint32_t *ts) {
+  if (input_len < 7) {
+    return -1;
+  }
+
+  const unsigned char *s = (const unsigned char *)input;
+  uint64_t bits = 0;
+  uint8_t check = 0;
+  for (int i = 0; i < 7; i++) {
+    uint8_t v = BASE32HEX_VALUES[s[i]];
+    check |= v;
+    bits = (bits << 5) | v;
+  }
+  if (check & 0xE0) {
+    return -1;
+  }
+
+  *ts = (uint32_t)(bits >> 3);
+  return 0;
 }
 
-// Read 24-bit big-endian value from bytes
-static uint32_t read_be24(const uint8_t *bytes) {
-  return ((uint32_t)bytes[0] << 16) | ((uint32_t)bytes[1] << 8) |
-         ((uint32_t)bytes[2]);
+int oast_decode_nonce_int(const char *input, size_t input_len, uint64_t *hi,
+                          uint64_t *lo) {
+  oast_decode_view_t view;
+  if (oast_decode_view(input, input_len, &view) != OAST_DECODE_OK ||
+      !zbase32_decode_bits(input + view.nonce_off, view.nonce_len, hi, lo)) {
+    return -1;
+  }
+  return 0;
 }
 
-int oast_decode(const char *input, size_t input_len, oast_decoded_t *result) {
-  memset(result, 0, sizeof(*result));
+void oast_ts_prefix_bounds(uint32_t ts_lo, uint32_t ts_hi,
+                           char lo[OAST_TS_PREFIX_LEN],
+                           char hi[OAST_TS_PREFIX_LEN + 1]) {
+  base32hex_encode_bits((uint64_t)ts_lo << 3, OAST_TS_PREFIX_LEN, lo);
+  base32hex_encode_bits(((uint64_t)ts_hi << 3) | 0x7, OAST_TS_PREFIX_LEN, hi);
+  hi[OAST_TS_PREFIX_LEN] = '~';
+}
 
-  // Store original input
-  size_t copy_len = input_len < sizeof(result->original) - 1
-                        ? input_len
-                        : sizeof(result->original) - 1;
-  memcpy(result->original, input, copy_len);
-  result->original[copy_len] = '\0';
+bool oast_decode_cid(const char *cid, size_t cid_len, oast_xid_t *xid) {
+  // A truncated correlation id decodes as an XID whose missing trailing
+  // chars are zero
+  const char *preamble = cid;
+  char padded[20];
+  if (cid_len < 20) {
+    memset(padded, '0', sizeof(padded));
+    memcpy(padded, cid, cid_len);
+    preamble = padded;
+  }
+
+  // The decode table accepts either case, so no lowercased copy is needed
+  return base32hex_decode_preamble(preamble, &xid->hi, &xid->lo);
+}
+
+oast_decode_status_t oast_decode_view(const char *input, size_t input_len,
+                                      oast_decode_view_t *view) {
+  return oast_decode_view_shape(input, input_len, OAST_SHAPE_DEFAULT, view);
+}
+
+oast_decode_status_t oast_decode_view_shape(const char *input,
+                                            size_t input_len,
+                                            oast_shape_t shape,
+                                            oast_decode_view_t *view) {
+  size_t cid_len = shape.cid_len;
+
+  view->xid.hi = 0;
+  view->xid.lo = 0;
+  view->subdomain_len = 0;
+  view->nonce_off = (uint16_t)cid_len;
+  view->nonce_len = 0;
 
-  // Check for empty input
   if (input_len == 0) {
-    strncpy(result->error, "empty input", sizeof(result->error) - 1);
-    return -1;
+    view->status = OAST_DECODE_EMPTY;
+    return OAST_DECODE_EMPTY;
   }
 
-  // Extract subdomain (everything before first dot, or whole input if no dot)
-  size_t subdomain_len = input_len;
-  const char *subdomain = input;
+  // Subdomain is everything before the first dot, or the whole input
+  const char *dot = memchr(input, '.', input_len);
+  size_t subdomain_len = dot ? (size_t)(dot - input) : input_len;
 
-  for (size_t i = 0; i < input_len; i++) {
-    if (input[i] == '.') {
-      subdomain_len = i;
-      break;
-    }
+  if (subdomain_len > OAST_MAX_SUBDOMAIN) {
+    view->status = OAST_DECODE_TOO_LONG;
+    return OAST_DECODE_TOO_LONG;
   }
+  view->subdomain_len = (uint16_t)subdomain_len;
 
-  // Lowercase subdomain for comparison (using stack buffer)
-  char subdomain_lower[256];
-  if (subdomain_len >= sizeof(subdomain_lower)) {
-    strncpy(result->error, "subdomain too long", sizeof(result->error) - 1);
-    return -1;
+  if (cid_len == 0 || subdomain_len < cid_len) {
+    view->status = OAST_DECODE_TOO_SHORT;
+    return OAST_DECODE_TOO_SHORT;
   }
 
-  for (size_t i = 0; i < subdomain_len; i++) {
-    subdomain_lower[i] = tolower(subdomain[i]);
+  if (!oast_decode_cid(input, cid_len, &view->xid)) {
+    view->xid.hi = 0;
+    view->xid.lo = 0;
+    view->status = OAST_DECODE_BAD_PREAMBLE;
+    return OAST_DECODE_BAD_PREAMBLE;
   }
-  subdomain_lower[subdomain_len] = '\0';
 
-  // Check minimum length (20 chars for preamble)
-  if (subdomain_len < 20) {
-    snprintf(result->error, sizeof(result->error),
-             "subdomain too short: %zu chars (minimum 20)", subdomain_len);
-    return -1;
-  }
+  view->nonce_len = (uint16_t)(subdomain_len - cid_len);
+  view->status = OAST_DECODE_OK;
+  return OAST_DECODE_OK;
+}
 
-  // Extract preamble (first 20 chars)
-  const char *preamble = subdomain_lower;
+void oast_decode_batch(const char **ptrs, const size_t *lens, size_t n,
+                       const oast_decode_columns_t *out) {
+  oast_decode_batch_shape(ptrs, lens, n, OAST_SHAPE_DEFAULT, out);
+}
 
-  // Validate preamble
-  if (!oast_is_valid_preamble(preamble, 20)) {
-    strncpy(result->error, "preamble contains invalid base32hex characters",
-            sizeof(result->error) - 1);
-    return -1;
+void oast_decode_xid_columns(const uint64_t *hi, const uint32_t *lo,
+                             size_t n, const oast_decode_columns_t *out) {
+  // One branch-free loop per requested column
+  if (out->ts) {
+    int64_t *ts = out->ts;
+    for (size_t i = 0; i < n; i++) {
+      ts[i] = (int64_t)(hi[i] >> 32);
+    }
+  }
+  if (out->machine_id) {
+    uint32_t *machine_id = out->machine_id;
+    for (size_t i = 0; i < n; i++) {
+      machine_id[i] = (uint32_t)(hi[i] >> 8) & 0xFFFFFF;
+    }
+  }
+  if (out->pid) {
+    int32_t *pid = out->pid;
+    for (size_t i = 0; i < n; i++) {
+      pid[i] = (int32_t)(((hi[i] & 0xFF) << 8) | (lo[i] >> 24));
+    }
+  }
+  if (out->counter) {
+    int32_t *counter = out->counter;
+    for (size_t i = 0; i < n; i++) {
+      counter[i] = (int32_t)(lo[i] & 0xFFFFFF);
+    }
   }
+}
 
-  // Extract nonce if present
-  if (subdomain_len > 20) {
-    size_t nonce_len = subdomain_len - 20;
-    if (nonce_len < sizeof(result->nonce)) {
-      memcpy(result->nonce, subdomain_lower + 20, nonce_len);
-      result->nonce[nonce_len] = '\0';
+void oast_decode_batch_shape(const char **ptrs, const size_t *lens, size_t n,
+                             oast_shape_t shape,
+                             const oast_decode_columns_t *out) {
+  uint64_t hi[OAST_DECODE_BATCH_BLOCK];
+  uint32_t lo[OAST_DECODE_BATCH_BLOCK];
+  uint8_t status[OAST_DECODE_BATCH_BLOCK];
+
+  for (size_t base = 0; base < n; base += OAST_DECODE_BATCH_BLOCK) {
+    size_t m = n - base < OAST_DECODE_BATCH_BLOCK ? n - base
+                                                  : OAST_DECODE_BATCH_BLOCK;
+
+    // Pass 1: locate and decode the preambles (the only per-row branching)
+    for (size_t i = 0; i < m; i++) {
+      oast_decode_view_t view;
+      status[i] = (uint8_t)oast_decode_view_shape(
+          ptrs[base + i], lens[base + i], shape, &view);
+      hi[i] = view.xid.hi;
+      lo[i] = view.xid.lo;
+      if (out->nonce_len) {
+        out->nonce_len[base + i] = view.nonce_len;
+      }
+    }
+
+    // Pass 2: one tight loop per requested column
+    oast_decode_columns_t block = {
+        out->ts ? out->ts + base : NULL,
+        out->machine_id ? out->machine_id + base : NULL,
+        out->pid ? out->pid + base : NULL,
+        out->counter ? out->counter + base : NULL,
+        NULL, NULL, NULL};
+    oast_decode_xid_columns(hi, lo, m, &block);
+    if (out->valid) {
+      bool *valid = out->valid + base;
+      for (size_t i = 0; i < m; i++) {
+        valid[i] = status[i] == OAST_DECODE_OK;
+      }
+    }
+    if (out->status) {
+      memcpy(out->status + base, status, m);
     }
   }
+}
 
-  // Decode preamble
-  uint8_t bytes[12];
-  size_t decoded_len = 0;
+// Lowercase n bytes of src into dst and NUL-terminate
+static void copy_lower(char *dst, const char *src, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    dst[i] = (char)tolower((unsigned char)src[i]);
+  }
+  dst[n] = '\0';
+}
+
+static const char *DECODE_ERROR_MESSAGES[OAST_DECODE_STATUS_COUNT] = {
+    NULL,
+    "empty input",
+    "subdomain too long",
+    "subdomain shorter than the correlation id",
+    "preamble contains invalid base32hex characters",
+};
+
+const char *oast_decode_error_message(unsigned code) {
+  return code < OAST_DECODE_STATUS_COUNT ? DECODE_ERROR_MESSAGES[code] : NULL;
+}
+
+int oast_decode(const char *input, size_t input_len, oast_decoded_t *result) {
+  memset(result, 0, sizeof(*result));
+
+  // Store original input
+  size_t copy_len = input_len < sizeof(result->original) - 1
+                        ? input_len
+                        : sizeof(result->original) - 1;
+  memcpy(result->original, input, copy_len);
+  result->original[copy_len] = '\0';
 
-  if (base32hex_decode(preamble, 20, bytes, &decoded_len) != 0 ||
-      decoded_len != 12) {
-    strncpy(result->error, "failed to decode preamble",
-            sizeof(result->error) - 1);
+  // Failures only record the code; message text is looked up on demand
+  oast_decode_view_t view;
+  result->error_code = (uint8_t)oast_decode_view(input, input_len, &view);
+  if (result->error_code != OAST_DECODE_OK) {
     return -1;
   }
 
-  // Extract fields from 12-byte array
-
-  // Bytes 0-3: timestamp (big-endian uint32)
-  result->timestamp = read_be32(bytes);
+  // Extract nonce if present
+  if (view.nonce_len > 0 && view.nonce_len < sizeof(result->nonce)) {
+    copy_lower(result->nonce, input + view.nonce_off, view.nonce_len);
+  }
 
-  // Bytes 4-6: machine ID (3 bytes)
-  result->machine_id[0] = bytes[4];
-  result->machine_id[1] = bytes[5];
-  result->machine_id[2] = bytes[6];
+  // Extract fields from the 96-bit XID
+  result->timestamp = oast_xid_timestamp(&view.xid);
 
-  // Bytes 7-8: PID (big-endian uint16)
-  result->pid = read_be16(bytes + 7);
+  uint32_t machine_id = oast_xid_machine_id(&view.xid);
+  result->machine_id[0] = (uint8_t)(machine_id >> 16);
+  result->machine_id[1] = (uint8_t)(machine_id >> 8);
+  result->machine_id[2] = (uint8_t)machine_id;
 
-  // Bytes 9-11: counter (24-bit big-endian)
-  result->counter = read_be24(bytes + 9);
+  result->pid = oast_xid_pid(&view.xid);
+  result->counter = oast_xid_counter(&view.xid);
 
   // Extract K-sort and campaign identifiers
-  memcpy(result->ksort, preamble, 6);
-  result->ksort[6] = '\0';
-
-  memcpy(result->campaign, preamble + 6, 5);
-  result->campaign[5] = '\0';
+  copy_lower(result->ksort, input, 6);
+  copy_lower(result->campaign, input + 6, 5);
 
   result->valid = true;
   return 0;
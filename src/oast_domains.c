@@ -1,4 +1,5 @@
 #include "oast_domains.h"
+#include <stdint.h>
 #include <string.h>
 
 // Known OAST domain suffixes
@@ -6,32 +7,147 @@ const char *KNOWN_OAST_DOMAINS[] = {
     "oast.pro", "oast.live",   "oast.site",      "oast.online", "oast.fun",
     "oast.me",  "interact.sh", "interactsh.com", NULL};
 
-const char *is_known_oast_domain(const char *domain, size_t domain_len) {
-  for (int i = 0; KNOWN_OAST_DOMAINS[i] != NULL; i++) {
-    const char *suffix = KNOWN_OAST_DOMAINS[i];
-    size_t suffix_len = strlen(suffix);
-
-    if (domain_len >= suffix_len) {
-      const char *end = domain + domain_len - suffix_len;
-      if (memcmp(end, suffix, suffix_len) == 0) {
-        // Check boundary (must be start of string or after a dot)
-        if (domain_len == suffix_len || end[-1] == '.') {
-          return suffix;
-        }
+#define SUFFIX_MAX 32
+#define SUFFIX_MAX_LABELS 8
+#define SUFFIX_SLOT_BITS 6
+#define SUFFIX_SEED_TRIES 4096
+#define SUFFIX_SLOTS (1 << SUFFIX_SLOT_BITS)
+
+// Perfect hash over the suffix strings: every suffix lands in its own slot
+// under the seed found at build time, so a lookup is one hash and at most
+// one memcmp per candidate key. A key is the last k labels of the domain,
+// for each label count k some suffix has.
+typedef struct {
+  uint8_t slot[SUFFIX_SLOTS]; // suffix index + 1, 0 = empty
+  uint8_t len[SUFFIX_MAX];
+  uint32_t seed;
+  size_t max_len;
+  uint8_t label_mask; // bit k - 1 set if some suffix has k labels
+  int max_labels;
+  bool built;
+} suffix_table_t;
+
+static suffix_table_t suffixes;
+
+static inline uint32_t suffix_slot(const char *key, size_t len, uint32_t seed) {
+  uint32_t h = seed ^ (uint32_t)len;
+  for (size_t i = 0; i < len; i++) {
+    h = (h ^ (uint8_t)key[i]) * 0x01000193u; // FNV-1a step
+  }
+  return (h ^ (h >> 15)) & (SUFFIX_SLOTS - 1);
+}
+
+bool oast_domains_init(void) {
+  suffix_table_t *t = &suffixes;
+  if (t->built) {
+    return true;
+  }
+
+  int count = 0;
+  for (; KNOWN_OAST_DOMAINS[count] != NULL; count++) {
+    const char *suffix = KNOWN_OAST_DOMAINS[count];
+    size_t len = strlen(suffix);
+    int labels = 1;
+    for (const char *p = suffix; *p; p++) {
+      labels += *p == '.';
+    }
+    if (count >= SUFFIX_MAX || len > UINT8_MAX ||
+        labels > SUFFIX_MAX_LABELS) {
+      return false; // The table would drop suffixes the extractor matches
+    }
+    t->len[count] = (uint8_t)len;
+    if (t->len[count] > t->max_len) {
+      t->max_len = t->len[count];
+    }
+    t->label_mask |= (uint8_t)(1u << (labels - 1));
+    if (labels > t->max_labels) {
+      t->max_labels = labels;
+    }
+  }
+
+  // Search for a seed with no collisions (a few tries at this load factor)
+  bool found = false;
+  uint32_t seed = 0x811C9DC5u;
+  for (int tries = 0; tries < SUFFIX_SEED_TRIES && !found;
+       tries++, seed += 0x9E3779B9u) {
+    memset(t->slot, 0, sizeof(t->slot));
+    bool collision = false;
+    for (int i = 0; i < count && !collision; i++) {
+      uint32_t s = suffix_slot(KNOWN_OAST_DOMAINS[i], t->len[i], seed);
+      collision = t->slot[s] != 0;
+      t->slot[s] = (uint8_t)(i + 1);
+    }
+    if (!collision) {
+      t->seed = seed;
+      found = true;
+    }
+  }
+  if (!found) {
+    return false;
+  }
+
+  t->built = true;
+  return true;
+}
+
+// Look up key exactly; returns the suffix index or -1
+static inline int suffix_lookup(const char *key, size_t len) {
+  const suffix_table_t *t = &suffixes;
+  int idx = (int)t->slot[suffix_slot(key, len, t->seed)] - 1;
+  if (idx >= 0 && t->len[idx] == len &&
+      memcmp(key, KNOWN_OAST_DOMAINS[idx], len) == 0) {
+    return idx;
+  }
+  return -1;
+}
+
+int oast_match_suffix(const char *domain, size_t domain_len) {
+  const suffix_table_t *t = &suffixes;
+  const char *end = domain + domain_len;
+
+  // Find the last max_labels label starts, looking back no further than the
+  // longest suffix (plus its leading dot) can reach. A key also starts at
+  // the beginning of domain. key_len[k] is the length of the key of k + 1
+  // labels.
+  size_t window = domain_len < t->max_len + 1 ? domain_len : t->max_len + 1;
+  size_t key_len[SUFFIX_MAX_LABELS];
+  int keys = 0;
+  for (size_t i = 1; i <= window && keys < t->max_labels; i++) {
+    if (end[-(ptrdiff_t)i] == '.') {
+      key_len[keys++] = i - 1;
+    }
+  }
+  if (domain_len <= t->max_len && keys < t->max_labels) {
+    key_len[keys++] = domain_len;
+  }
+
+  // Most labels first, so a longer suffix wins over one it ends with
+  for (int k = keys - 1; k >= 0; k--) {
+    if (t->label_mask & (1u << k)) {
+      int idx = suffix_lookup(end - key_len[k], key_len[k]);
+      if (idx >= 0) {
+        return idx;
       }
     }
   }
-  return NULL;
+  return -1;
+}
+
+size_t oast_suffix_len(int index) { return suffixes.len[index]; }
+
+const char *is_known_oast_domain(const char *domain, size_t domain_len) {
+  int idx = oast_match_suffix(domain, domain_len);
+  return idx >= 0 ? KNOWN_OAST_DOMAINS[idx] : NULL;
 }
 
 size_t get_oast_subdomain(const char *full, size_t full_len,
                           const char **subdomain_out) {
-  const char *suffix = is_known_oast_domain(full, full_len);
-  if (!suffix) {
+  int idx = oast_match_suffix(full, full_len);
+  if (idx < 0) {
     return 0;
   }
 
-  size_t suffix_len = strlen(suffix);
+  size_t suffix_len = suffixes.len[idx];
   if (full_len == suffix_len) {
     // Just the domain, no subdomain
     return 0;
@@ -0,0 +1,46 @@
+#include "oast_encode.h"
+#include "oast_base32.h"
+#include "oast_decode.h"
+
+void oast_encode_preamble(uint32_t ts, uint32_t machine_id, uint16_t pid,
+                          uint32_t counter, char out[20]) {
+  uint64_t hi = ((uint64_t)ts << 32) | ((uint64_t)(machine_id & 0xFFFFFF) << 8) |
+                (uint64_t)(pid >> 8);
+  uint32_t lo = ((uint32_t)(pid & 0xFF) << 24) | (counter & 0xFFFFFF);
+
+  // Same split as the decoder: 96 XID bits + 4 zero padding bits as
+  // a = chars 0-11 (60 bits), b = chars 12-19 (40 bits)
+  uint64_t a = hi >> 4;
+  uint64_t b = ((hi & 0xF) << 36) | ((uint64_t)lo << 4);
+  base32hex_encode_bits(a, 12, out);
+  base32hex_encode_bits(b, 8, out + 12);
+}
+
+size_t oast_encode_nonce_int(uint64_t hi, uint64_t lo, char *out) {
+  // The sentinel is the highest set bit and must sit on a char boundary
+  int top;
+  if (hi != 0) {
+    top = 64;
+    for (uint64_t v = hi >> 1; v; v >>= 1) {
+      top++;
+    }
+  } else if (lo != 0) {
+    top = 0;
+    for (uint64_t v = lo >> 1; v; v >>= 1) {
+      top++;
+    }
+  } else {
+    return 0;
+  }
+  if (top == 0 || top % 5 != 0 || top / 5 > OAST_NONCE_INT_MAX_CHARS) {
+    return 0;
+  }
+
+  size_t len = (size_t)(top / 5);
+  for (size_t i = len; i-- > 0;) {
+    out[i] = ZBASE32_ALPHABET[lo & 0x1F];
+    lo = (lo >> 5) | (hi << 59);
+    hi >>= 5;
+  }
+  return len;
+}
@@ -1,7 +1,9 @@
 #include "duckdb_extension.h"
 
+#include "oast_extract.h"
 #include "oast_functions.h"
 #include "oast_macros.h"
+#include "oast_simd.h"
 
 #include <stdio.h>
 #include <string.h>
@@ -32,37 +34,30 @@ DUCKDB_EXTENSION_ENTRYPOINT(duckdb_connection connection,
                             struct duckdb_extension_access *access) {
   char err[512];
 
+  // Build the extraction automaton from the known domain list
+  if (!oast_extract_init()) {
+    access->set_error(info, "OAST suffix list exceeds the limits of the "
+                            "suffix lookup table or extraction automaton");
+    return false;
+  }
+
+  // Pick SSE4.1/AVX2/scalar kernels for this CPU once, before any query
+  oast_simd_init();
 
   // Register OAST scalar functions (must be registered before macros)
   RegisterOASTFunctions(connection);
 
   // Register SQL macros that wrap scalar functions.
-  // These provide ergonomic STRUCT outputs and field accessors without
-  // needing C API STRUCT creation.
+  // These provide ergonomic aliases and table forms on top
+  // of the native functions.
 
-  // Struct macros (multi-field, single JSON parse)
+  // Struct macros (multi-field, single native decode)
   if (!register_macro(connection, OAST_STRUCT_MACRO, "oast_struct", err,
                       sizeof(err)) ||
-      !register_macro(connection, OAST_SUMMARY_MACRO, "oast_summary", err,
-                      sizeof(err)) ||
-
-      // Field accessor macros (single-field convenience)
-      !register_macro(connection, OAST_TIMESTAMP_MACRO, "oast_timestamp", err,
-                      sizeof(err)) ||
-      !register_macro(connection, OAST_CAMPAIGN_MACRO, "oast_campaign", err,
-                      sizeof(err)) ||
-      !register_macro(connection, OAST_KSORT_MACRO, "oast_ksort", err,
-                      sizeof(err)) ||
-      !register_macro(connection, OAST_MACHINE_ID_MACRO, "oast_machine_id",
-                      err, sizeof(err)) ||
 
       // Extraction helper macros
-      !register_macro(connection, OAST_COUNT_MACRO, "oast_count", err,
-                      sizeof(err)) ||
-      !register_macro(connection, OAST_HAS_OAST_MACRO, "oast_has_oast", err,
+      !register_macro(connection, OAST_EXTRACT_MACRO, "oast_extract", err,
                       sizeof(err)) ||
-      !register_macro(connection, OAST_EXTRACT_STRUCTS_MACRO,
-                      "oast_extract_structs", err, sizeof(err)) ||
       !register_macro(connection, OAST_FIRST_MACRO, "oast_first", err,
                       sizeof(err)) ||
 
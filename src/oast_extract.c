@@ -1,166 +1,871 @@
 #include "oast_extract.h"
 #include "oast_base32.h"
+#include "oast_cpu.h"
+#include "oast_decode.h"
 #include "oast_domains.h"
 #include "oast_validate.h"
 #include <ctype.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(OAST_HAVE_SSE2)
+#include <immintrin.h>
+#endif
+
 // Check if character is valid for OAST subdomain (base32hex or z-base-32 or
 // hyphen/underscore)
-static bool is_subdomain_char(char c) {
-  c = tolower(c);
-  return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || c == '-' ||
-         c == '_';
+static inline bool is_subdomain_char(char c) {
+  return oast_char_has(c, OAST_CC_SUBDOMAIN);
 }
 
-// Find start of subdomain by walking backwards from dot
-// Returns start position, or -1 if invalid
-static int find_subdomain_start(const char *text, size_t dot_pos) {
-  if (dot_pos == 0) {
-    return -1;
+// Subdomain checks for extracted candidates (see oast_extract_kernel)
+static bool extracted_subdomain_shape(const char *s, size_t len,
+                                      oast_shape_t shape) {
+  return oast_shape_match(s, len, shape.cid_len, shape.nonce_len,
+                          OAST_CC_NONCE);
+}
+
+#define OAST_DEFINE_EXTRACT_KERNEL(CID, NONCE)                                 \
+  static bool extracted_subdomain_##CID##_##NONCE(const char *s, size_t len,   \
+                                                  oast_shape_t shape) {        \
+    (void)shape;                                                               \
+    return oast_shape_match(s, len, CID, NONCE, OAST_CC_NONCE);                \
   }
+OAST_SHAPE_KERNELS(OAST_DEFINE_EXTRACT_KERNEL)
+#undef OAST_DEFINE_EXTRACT_KERNEL
+
+oast_subdomain_fn oast_extract_kernel(oast_shape_t shape) {
+#define OAST_PICK_EXTRACT_KERNEL(CID, NONCE)                                   \
+  if (shape.cid_len == CID && shape.nonce_len == NONCE) {                      \
+    return extracted_subdomain_##CID##_##NONCE;                                \
+  }
+  OAST_SHAPE_KERNELS(OAST_PICK_EXTRACT_KERNEL)
+#undef OAST_PICK_EXTRACT_KERNEL
+  return extracted_subdomain_shape;
+}
+
+// Slots a seen set holds before it first allocates
+#define OAST_SEEN_INLINE 64
 
-  int pos = (int)dot_pos - 1;
+// Open-addressing set of the domains one scan has recorded, for dedup.
+// A slot holds hash << 32 | (arena index + 1), 0 when empty; the table is
+// kept at most half full, so probes are short.
+typedef struct {
+  uint64_t *slots;
+  size_t mask; // Capacity - 1 (a power of two)
+  size_t count;
+  uint64_t inline_slots[OAST_SEEN_INLINE];
+} seen_set_t;
 
-  // Walk backwards while we have valid subdomain characters
-  while (pos >= 0 && is_subdomain_char(text[pos])) {
+// Match sink shared by the scan kernels. Matches are appended to arena when
+// it is non-NULL; otherwise only counted. check and shape are the subdomain
+// shape being extracted; suffix_mask (NULL = all) and seen (NULL = keep
+// repeats) come from oast_extract_opts_t.
+typedef struct {
+  oast_span_arena_t *arena;
+  size_t count; // Matches found by this scan
+  size_t limit; // 0 = no limit
+  oast_subdomain_fn check;
+  oast_shape_t shape;
+  const uint64_t *suffix_mask;
+  seen_set_t *seen;
+} scan_sink_t;
+
+static inline bool suffix_allowed(const scan_sink_t *sink, int suffix_id) {
+  return !sink->suffix_mask ||
+         (sink->suffix_mask[suffix_id >> 6] >> (suffix_id & 63)) & 1;
+}
+
+// No valid subdomain start (check_candidate / find_subdomain_start)
+#define OAST_NO_START SIZE_MAX
+
+// Start of the label ending at dot_pos. Walks back over at most
+// OAST_MAX_LABEL subdomain chars, so a candidate costs O(1) however long the
+// run of [0-9A-Za-z_-] before it is. Returns OAST_NO_START if the label is
+// longer than OAST_MAX_LABEL.
+static size_t find_subdomain_start(const char *text, size_t dot_pos) {
+  size_t floor = dot_pos > OAST_MAX_LABEL ? dot_pos - OAST_MAX_LABEL : 0;
+  size_t pos = dot_pos;
+
+  while (pos > floor && is_subdomain_char(text[pos - 1])) {
     pos--;
   }
+  if (pos > 0 && is_subdomain_char(text[pos - 1])) {
+    return OAST_NO_START;
+  }
+  return pos;
+}
 
-  // pos now points to the character before the subdomain, or -1 if at start
-  int start = pos + 1;
-  size_t subdomain_len = dot_pos - start;
+// Aho-Corasick automaton over ".<suffix>" for every KNOWN_OAST_DOMAINS
+// entry, built once at load time. Input bytes are case-folded and mapped to a
+// small class alphabet (every byte not used by any suffix shares class 0), so
+// the full transition table stays a few KB and a scan is one table lookup per
+// byte no matter how many suffixes are configured.
+#define OAST_AC_MAX_STATES 1024
+#define OAST_AC_MAX_CLASSES 64
 
-  // Validate minimum length (20 chars for preamble + 13 for nonce = 33 minimum)
-  if (subdomain_len < 33) {
-    return -1;
+// SIMD anchor filter: '.' followed by one of at most this many distinct
+// (case-folded) first suffix bytes
+#define OAST_MAX_FIRST_BYTES 8
+
+typedef struct {
+  uint8_t byte_class[256];
+  uint8_t class_count;
+  uint16_t state_count;
+  uint16_t next[OAST_AC_MAX_STATES * OAST_AC_MAX_CLASSES];
+  int16_t out[OAST_AC_MAX_STATES];       // Suffix index ending here, or -1
+  uint16_t out_link[OAST_AC_MAX_STATES]; // Next state with output (0 = none)
+  uint16_t suffix_len[OAST_AC_MAX_STATES];
+  uint16_t depth[OAST_AC_MAX_STATES]; // Bytes from the root (anchored walks)
+  uint8_t first_bytes[OAST_MAX_FIRST_BYTES]; // Folded first suffix bytes
+  uint8_t first_byte_count; // 0 = too many distinct; anchor on '.' alone
+  bool built;
+} oast_automaton_t;
+
+static oast_automaton_t automaton;
+
+bool oast_extract_init(void) {
+  oast_automaton_t *ac = &automaton;
+  if (ac->built) {
+    return true;
   }
+  memset(ac, 0, sizeof(*ac));
 
-  // Validate first 20 chars are base32hex
-  for (size_t i = 0; i < 20; i++) {
-    if (!is_base32hex_char(text[start + i])) {
-      return -1;
+  if (!oast_domains_init()) {
+    return false;
+  }
+
+  // Class alphabet: one class per distinct (case-folded) suffix byte
+  ac->class_count = 1;
+  ac->byte_class['.'] = ac->class_count++;
+  for (int i = 0; KNOWN_OAST_DOMAINS[i] != NULL; i++) {
+    for (const char *p = KNOWN_OAST_DOMAINS[i]; *p; p++) {
+      unsigned char c = (unsigned char)tolower((unsigned char)*p);
+      if (ac->byte_class[c] == 0) {
+        if (ac->class_count >= OAST_AC_MAX_CLASSES) {
+          return false; // Too many distinct suffix bytes
+        }
+        ac->byte_class[c] = ac->class_count++;
+      }
     }
   }
+  for (int c = 'A'; c <= 'Z'; c++) {
+    ac->byte_class[c] = ac->byte_class[c - 'A' + 'a'];
+  }
 
-  // Validate remaining chars are valid (z-base-32 or hyphen/underscore)
-  for (size_t i = 20; i < subdomain_len; i++) {
-    char c = tolower(text[start + i]);
-    if (!is_zbase32_char(c) && c != '-' && c != '_') {
-      return -1;
+  const uint16_t classes = ac->class_count;
+  ac->state_count = 1;
+  ac->out[0] = -1;
+
+  // Trie of ".<suffix>" patterns (0 in next[] means "no edge" while building;
+  // the root is never a trie child so this is unambiguous)
+  for (int i = 0; KNOWN_OAST_DOMAINS[i] != NULL; i++) {
+    const char *suffix = KNOWN_OAST_DOMAINS[i];
+    uint16_t state = 0;
+    for (size_t j = 0; j <= strlen(suffix); j++) {
+      unsigned char c = j == 0 ? '.' : (unsigned char)suffix[j - 1];
+      uint16_t *edge = &ac->next[state * classes + ac->byte_class[c]];
+      if (*edge == 0) {
+        if (ac->state_count >= OAST_AC_MAX_STATES) {
+          return false; // Suffix list too large for the automaton
+        }
+        ac->out[ac->state_count] = -1;
+        *edge = ac->state_count++;
+      }
+      ac->depth[*edge] = (uint16_t)(j + 1);
+      state = *edge;
     }
+    ac->out[state] = (int16_t)i;
+    ac->suffix_len[state] = (uint16_t)strlen(suffix);
   }
 
-  return start;
+  // Anchor bytes for the SIMD candidate filter. Folding with | 0x20 maps
+  // upper to lower case letters (and may alias a few punctuation bytes,
+  // which only adds candidates that the automaton then rejects).
+  for (int i = 0; KNOWN_OAST_DOMAINS[i] != NULL; i++) {
+    uint8_t first = (uint8_t)(KNOWN_OAST_DOMAINS[i][0] | 0x20);
+    bool seen = false;
+    for (int k = 0; k < ac->first_byte_count; k++) {
+      seen = seen || ac->first_bytes[k] == first;
+    }
+    if (seen) {
+      continue;
+    }
+    if (ac->first_byte_count == OAST_MAX_FIRST_BYTES) {
+      ac->first_byte_count = 0;
+      break;
+    }
+    ac->first_bytes[ac->first_byte_count++] = first;
+  }
+
+  // Breadth-first: fill failure transitions into next[] (turning the trie
+  // into a DFA) and chain dictionary suffix links for output
+  uint16_t fail[OAST_AC_MAX_STATES];
+  uint16_t queue[OAST_AC_MAX_STATES];
+  size_t head = 0, tail = 0;
+
+  fail[0] = 0;
+  for (uint16_t c = 0; c < classes; c++) {
+    uint16_t child = ac->next[c];
+    if (child) {
+      fail[child] = 0;
+      queue[tail++] = child;
+    }
+  }
+
+  while (head < tail) {
+    uint16_t state = queue[head++];
+    uint16_t f = fail[state];
+    ac->out_link[state] = ac->out[f] >= 0 ? f : ac->out_link[f];
+
+    for (uint16_t c = 0; c < classes; c++) {
+      uint16_t *edge = &ac->next[state * classes + c];
+      if (*edge) {
+        fail[*edge] = ac->next[f * classes + c];
+        queue[tail++] = *edge;
+      } else {
+        *edge = ac->next[f * classes + c];
+      }
+    }
+  }
+
+  ac->built = true;
+
+#if defined(OAST_HAVE_AVX2)
+  if (oast_cpu_has_avx2()) {
+    oast_extract_set_kernel(OAST_SCAN_AVX2);
+    return true;
+  }
+#endif
+#if defined(OAST_HAVE_SSE2)
+  oast_extract_set_kernel(OAST_SCAN_SSE2);
+#endif
+  return true;
 }
 
-int oast_extract(const char *text, size_t text_len, oast_match_t **matches_out,
-                 size_t *match_count_out) {
-  *matches_out = NULL;
-  *match_count_out = 0;
+// Check a suffix hit ending at domain_end. Returns the subdomain start, or
+// OAST_NO_START if there is no valid OAST subdomain / boundary around it.
+static size_t check_candidate(const char *text, size_t text_len,
+                              size_t domain_end, size_t suffix_len,
+                              const scan_sink_t *sink) {
+  // The automaton pattern includes the dot, so text[dot_pos] == '.'
+  size_t dot_pos = domain_end - suffix_len - 1;
 
-  if (text_len == 0 || !text) {
-    return 0;
+  // Also rejects a label with no boundary before it
+  size_t subdomain_start = find_subdomain_start(text, dot_pos);
+  if (subdomain_start == OAST_NO_START) {
+    return OAST_NO_START;
   }
 
-  // Allocate initial capacity for matches
-  size_t capacity = 16;
-  oast_match_t *matches = malloc(sizeof(oast_match_t) * capacity);
-  if (!matches) {
-    return -1;
+  // Correlation id must be base32hex, the rest z-base-32 or hyphen/underscore
+  if (!sink->check(text + subdomain_start, dot_pos - subdomain_start,
+                   sink->shape)) {
+    return OAST_NO_START;
   }
-  size_t match_count = 0;
 
-  // Scan for known OAST domain suffixes
-  for (int i = 0; KNOWN_OAST_DOMAINS[i] != NULL; i++) {
-    const char *domain = KNOWN_OAST_DOMAINS[i];
-    size_t domain_len = strlen(domain);
+  // Check for boundary after domain (end of string, whitespace, or
+  // non-subdomain char)
+  if (domain_end < text_len) {
+    char after = text[domain_end];
+    if (is_subdomain_char(after) || after == '.') {
+      // Not a valid boundary (might be part of longer domain)
+      return OAST_NO_START;
+    }
+  }
 
-    // Skip if text is shorter than domain
-    if (text_len < domain_len) {
+  return subdomain_start;
+}
+
+void oast_span_arena_init(oast_span_arena_t *arena) {
+  arena->spans = arena->inline_spans;
+  arena->xids = NULL;
+  arena->count = 0;
+  arena->capacity = OAST_SPAN_ARENA_INLINE;
+}
+
+void oast_span_arena_init_decoding(oast_span_arena_t *arena) {
+  oast_span_arena_init(arena);
+  arena->xids = arena->inline_xids;
+}
+
+void oast_span_arena_free(oast_span_arena_t *arena) {
+  if (arena->spans != arena->inline_spans) {
+    free(arena->spans);
+  }
+  if (arena->xids && arena->xids != arena->inline_xids) {
+    free(arena->xids);
+  }
+  arena->spans = arena->inline_spans;
+  arena->xids = arena->xids ? arena->inline_xids : NULL;
+  arena->count = 0;
+  arena->capacity = OAST_SPAN_ARENA_INLINE;
+}
+
+// Move *array (count elements of size bytes, initially inline_array) to a
+// heap buffer of capacity elements. Returns false on allocation failure,
+// leaving *array unchanged.
+static bool grow_array(void **array, void *inline_array, size_t count,
+                       size_t capacity, size_t size) {
+  void *grown;
+  if (*array == inline_array) {
+    grown = malloc(size * capacity);
+    if (grown) {
+      memcpy(grown, inline_array, size * count);
+    }
+  } else {
+    grown = realloc(*array, size * capacity);
+  }
+  if (!grown) {
+    return false;
+  }
+  *array = grown;
+  return true;
+}
+
+// Double the arena's capacity, moving the inline spans (and XIDs) to the
+// heap on the first call. Returns false on allocation failure.
+static bool span_arena_grow(oast_span_arena_t *arena) {
+  size_t capacity = arena->capacity * 2;
+  void *spans = arena->spans;
+  if (!grow_array(&spans, arena->inline_spans, arena->count, capacity,
+                  sizeof(oast_span_t))) {
+    return false;
+  }
+  arena->spans = spans;
+  if (arena->xids) {
+    void *xids = arena->xids;
+    if (!grow_array(&xids, arena->inline_xids, arena->count, capacity,
+                    sizeof(oast_xid_t))) {
+      return false; // spans is larger than capacity, which is harmless
+    }
+    arena->xids = xids;
+  }
+  arena->capacity = capacity;
+  return true;
+}
+
+static void seen_init(seen_set_t *seen) {
+  seen->slots = seen->inline_slots;
+  seen->mask = OAST_SEEN_INLINE - 1;
+  seen->count = 0;
+  memset(seen->inline_slots, 0, sizeof(seen->inline_slots));
+}
+
+static void seen_free(seen_set_t *seen) {
+  if (seen->slots != seen->inline_slots) {
+    free(seen->slots);
+  }
+}
+
+// Domain bytes are [0-9A-Za-z._-], for which | 0x20 folds case without
+// merging distinct characters
+static uint32_t seen_hash(const char *s, size_t len) {
+  uint32_t h = 2166136261u; // FNV-1a
+  for (size_t i = 0; i < len; i++) {
+    h = (h ^ (uint8_t)(s[i] | 0x20)) * 16777619u;
+  }
+  return h;
+}
+
+static bool seen_equal(const char *a, const char *b, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    if ((a[i] | 0x20) != (b[i] | 0x20)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Probe for the domain text[start, start + len) with hash h. Returns the
+// slot holding an equal domain, or the empty slot where it belongs.
+static uint64_t *seen_probe(const seen_set_t *seen, const char *text,
+                            const oast_span_t *spans, size_t start,
+                            size_t len, uint32_t h) {
+  for (size_t i = h & seen->mask;; i = (i + 1) & seen->mask) {
+    uint64_t slot = seen->slots[i];
+    if (slot == 0) {
+      return &seen->slots[i];
+    }
+    const oast_span_t *other = &spans[(uint32_t)slot - 1];
+    if ((uint32_t)(slot >> 32) == h && other->len == len &&
+        seen_equal(text + other->start, text + start, len)) {
+      return &seen->slots[i];
+    }
+  }
+}
+
+// Double the table and rehash. Returns false on allocation failure.
+static bool seen_grow(seen_set_t *seen) {
+  size_t capacity = (seen->mask + 1) * 2;
+  uint64_t *slots = calloc(capacity, sizeof(uint64_t));
+  if (!slots) {
+    return false;
+  }
+  for (size_t i = 0; i <= seen->mask; i++) {
+    uint64_t slot = seen->slots[i];
+    if (slot == 0) {
       continue;
     }
+    size_t j = (size_t)(slot >> 32) & (capacity - 1);
+    while (slots[j] != 0) {
+      j = (j + 1) & (capacity - 1);
+    }
+    slots[j] = slot;
+  }
+  seen_free(seen);
+  seen->slots = slots;
+  seen->mask = capacity - 1;
+  return true;
+}
 
-    // Search for this domain in the text
-    for (size_t pos = 0; pos <= text_len - domain_len; pos++) {
-      // Case-insensitive comparison
-      bool match = true;
-      for (size_t j = 0; j < domain_len; j++) {
-        if (tolower(text[pos + j]) != tolower(domain[j])) {
-          match = false;
-          break;
-        }
-      }
+// Record a validated match. Returns 1 once the limit is reached, -1 on
+// allocation failure, 0 to keep scanning.
+static int record_match(scan_sink_t *sink, const char *text,
+                        size_t subdomain_start, size_t domain_end,
+                        uint16_t hit) {
+  oast_span_arena_t *arena = sink->arena;
+
+  uint64_t *seen_slot = NULL;
+  uint32_t hash = 0;
+  if (sink->seen) {
+    // Repeats are dropped before they count towards the limit
+    size_t len = domain_end - subdomain_start;
+    hash = seen_hash(text + subdomain_start, len);
+    seen_slot = seen_probe(sink->seen, text, arena->spans, subdomain_start,
+                           len, hash);
+    if (*seen_slot != 0) {
+      return 0;
+    }
+  }
+
+  if (arena) {
+    if (arena->count == arena->capacity && !span_arena_grow(arena)) {
+      return -1;
+    }
+    if (arena->xids) {
+      // The correlation id passed sink->check, so it always decodes
+      oast_decode_cid(text + subdomain_start, sink->shape.cid_len,
+                      &arena->xids[arena->count]);
+    }
+    oast_span_t *span = &arena->spans[arena->count++];
+    span->start = (uint32_t)subdomain_start;
+    span->len = (uint32_t)(domain_end - subdomain_start);
+    span->suffix_id = (uint16_t)automaton.out[hit];
+  }
 
-      if (!match) {
+  if (seen_slot) {
+    *seen_slot = (uint64_t)hash << 32 | (uint32_t)arena->count;
+    if (++sink->seen->count * 2 > sink->seen->mask + 1 &&
+        !seen_grow(sink->seen)) {
+      return -1;
+    }
+  }
+
+  sink->count++;
+  return sink->limit && sink->count >= sink->limit ? 1 : 0;
+}
+
+// Scalar kernel: run the automaton over every byte
+static int scan_scalar(const char *text, size_t text_len, scan_sink_t *sink) {
+  const oast_automaton_t *ac = &automaton;
+  const uint16_t classes = ac->class_count;
+  uint16_t state = 0;
+
+  for (size_t pos = 0; pos < text_len; pos++) {
+    state = ac->next[state * classes +
+                     ac->byte_class[(unsigned char)text[pos]]];
+
+    // Walk every suffix ending at this byte (longest first)
+    for (uint16_t hit = ac->out[state] >= 0 ? state : ac->out_link[state];
+         hit != 0; hit = ac->out_link[hit]) {
+      if (!suffix_allowed(sink, ac->out[hit])) {
         continue;
       }
-
-      // Found a domain match. Now check if there's a valid subdomain before it.
-      // Need a dot immediately before the domain
-      if (pos == 0 || text[pos - 1] != '.') {
+      size_t domain_end = pos + 1;
+      size_t subdomain_start =
+          check_candidate(text, text_len, domain_end, ac->suffix_len[hit],
+                          sink);
+      if (subdomain_start == OAST_NO_START) {
         continue;
       }
 
-      size_t dot_pos = pos - 1;
+      // Valid OAST match found!
+      int rc = record_match(sink, text, subdomain_start, domain_end, hit);
+      if (rc != 0) {
+        return rc < 0 ? -1 : 0;
+      }
 
-      // Find subdomain start
-      int subdomain_start = find_subdomain_start(text, dot_pos);
-      if (subdomain_start < 0) {
-        continue;
+      // Restart from the root past this match to avoid overlapping matches
+      state = 0;
+      break;
+    }
+  }
+
+  return 0;
+}
+
+// Anchored automaton walk from a candidate dot. Follows only trie edges
+// (depth must track bytes consumed) and checks every suffix that starts at
+// this dot. Returns 1/-1 like record_match, 0 otherwise; *resume_out is set
+// to the end of a recorded match.
+static int scan_anchor(const char *text, size_t text_len, size_t dot_pos,
+                       scan_sink_t *sink, size_t *resume_out) {
+  const oast_automaton_t *ac = &automaton;
+  const uint16_t classes = ac->class_count;
+  uint16_t state = 0;
+
+  for (size_t pos = dot_pos; pos < text_len; pos++) {
+    state = ac->next[state * classes +
+                     ac->byte_class[(unsigned char)text[pos]]];
+    if (ac->depth[state] != pos - dot_pos + 1) {
+      break;
+    }
+    if (ac->out[state] < 0 || !suffix_allowed(sink, ac->out[state])) {
+      continue;
+    }
+
+    size_t domain_end = pos + 1;
+    size_t subdomain_start =
+        check_candidate(text, text_len, domain_end, ac->suffix_len[state],
+                        sink);
+    if (subdomain_start != OAST_NO_START) {
+      *resume_out = domain_end;
+      int rc = record_match(sink, text, subdomain_start, domain_end, state);
+      return rc != 0 ? rc : 2;
+    }
+  }
+  return 0;
+}
+
+// Scalar anchor filter for the bytes SIMD blocks do not cover
+static int scan_anchor_tail(const char *text, size_t text_len, size_t pos,
+                            scan_sink_t *sink) {
+  for (; pos < text_len; pos++) {
+    const char *dot = memchr(text + pos, '.', text_len - pos);
+    if (!dot) {
+      break;
+    }
+    pos = (size_t)(dot - text);
+
+    size_t resume = pos;
+    int rc = scan_anchor(text, text_len, pos, sink, &resume);
+    if (rc == 1 || rc == -1) {
+      return rc < 0 ? -1 : 0;
+    }
+    if (rc == 2) {
+      pos = resume - 1;
+    }
+  }
+  return 0;
+}
+
+#if defined(OAST_HAVE_SSE2)
+// SSE2 blocks: 16 bytes at a time, find '.' followed by a suffix first byte
+// and only run the automaton from those anchors. Advances *pos_io past the
+// bytes covered; returns 1/-1 like record_match, 0 otherwise.
+static inline int scan_sse2_blocks(const char *text, size_t text_len,
+                                   size_t *pos_io, scan_sink_t *sink) {
+  const oast_automaton_t *ac = &automaton;
+  const __m128i dot = _mm_set1_epi8('.');
+  const __m128i fold = _mm_set1_epi8(0x20);
+  size_t pos = *pos_io;
+
+  // Each block also reads the byte after it
+  while (pos + 17 <= text_len) {
+    __m128i cur = _mm_loadu_si128((const __m128i *)(text + pos));
+    __m128i dots = _mm_cmpeq_epi8(cur, dot);
+    uint32_t mask = (uint32_t)_mm_movemask_epi8(dots);
+
+    if (mask && ac->first_byte_count) {
+      __m128i next = _mm_or_si128(
+          _mm_loadu_si128((const __m128i *)(text + pos + 1)), fold);
+      __m128i firsts = _mm_setzero_si128();
+      for (int k = 0; k < ac->first_byte_count; k++) {
+        firsts = _mm_or_si128(
+            firsts,
+            _mm_cmpeq_epi8(next, _mm_set1_epi8((char)ac->first_bytes[k])));
       }
+      mask &= (uint32_t)_mm_movemask_epi8(firsts);
+    }
 
-      // Check for boundary before subdomain (start of string, whitespace, or
-      // non-subdomain char)
-      if (subdomain_start > 0) {
-        char before = text[subdomain_start - 1];
-        if (is_subdomain_char(before)) {
-          // Not a valid boundary
-          continue;
-        }
+    size_t next_pos = pos + 16;
+    while (mask) {
+      size_t dot_pos = pos + oast_ctz32(mask);
+      mask &= mask - 1;
+
+      size_t resume = 0;
+      int rc = scan_anchor(text, text_len, dot_pos, sink, &resume);
+      if (rc == 1 || rc == -1) {
+        return rc;
       }
+      if (rc == 2) {
+        // Skip past the match (no overlapping matches)
+        next_pos = resume;
+        break;
+      }
+    }
+    pos = next_pos;
+  }
 
-      // Check for boundary after domain (end of string, whitespace, or
-      // non-subdomain char)
-      size_t domain_end = pos + domain_len;
-      if (domain_end < text_len) {
-        char after = text[domain_end];
-        if (is_subdomain_char(after) || after == '.') {
-          // Not a valid boundary (might be part of longer domain)
-          continue;
-        }
+  *pos_io = pos;
+  return 0;
+}
+
+// SSE2 kernel
+static int scan_sse2(const char *text, size_t text_len, scan_sink_t *sink) {
+  size_t pos = 0;
+  int rc = scan_sse2_blocks(text, text_len, &pos, sink);
+  if (rc != 0) {
+    return rc < 0 ? -1 : 0;
+  }
+  return scan_anchor_tail(text, text_len, pos, sink);
+}
+#endif
+
+#if defined(OAST_HAVE_AVX2)
+// AVX2 kernel: same filter over 32-byte blocks, then SSE2 blocks and the
+// scalar tail for what is left
+OAST_TARGET_AVX2
+static int scan_avx2(const char *text, size_t text_len, scan_sink_t *sink) {
+  const oast_automaton_t *ac = &automaton;
+  const __m256i dot = _mm256_set1_epi8('.');
+  const __m256i fold = _mm256_set1_epi8(0x20);
+  size_t pos = 0;
+
+  while (pos + 33 <= text_len) {
+    __m256i cur = _mm256_loadu_si256((const __m256i *)(text + pos));
+    __m256i dots = _mm256_cmpeq_epi8(cur, dot);
+    uint32_t mask = (uint32_t)_mm256_movemask_epi8(dots);
+
+    if (mask && ac->first_byte_count) {
+      __m256i next = _mm256_or_si256(
+          _mm256_loadu_si256((const __m256i *)(text + pos + 1)), fold);
+      __m256i firsts = _mm256_setzero_si256();
+      for (int k = 0; k < ac->first_byte_count; k++) {
+        firsts = _mm256_or_si256(
+            firsts,
+            _mm256_cmpeq_epi8(next, _mm256_set1_epi8((char)ac->first_bytes[k])));
       }
+      mask &= (uint32_t)_mm256_movemask_epi8(firsts);
+    }
 
-      // Valid OAST match found!
-      if (match_count >= capacity) {
-        capacity *= 2;
-        oast_match_t *new_matches =
-            realloc(matches, sizeof(oast_match_t) * capacity);
-        if (!new_matches) {
-          free(matches);
-          return -1;
-        }
-        matches = new_matches;
+    size_t next_pos = pos + 32;
+    while (mask) {
+      size_t dot_pos = pos + oast_ctz32(mask);
+      mask &= mask - 1;
+
+      size_t resume = 0;
+      int rc = scan_anchor(text, text_len, dot_pos, sink, &resume);
+      if (rc == 1 || rc == -1) {
+        return rc < 0 ? -1 : 0;
+      }
+      if (rc == 2) {
+        next_pos = resume;
+        break;
       }
+    }
+    pos = next_pos;
+  }
+
+  int rc = scan_sse2_blocks(text, text_len, &pos, sink);
+  if (rc != 0) {
+    return rc < 0 ? -1 : 0;
+  }
+  return scan_anchor_tail(text, text_len, pos, sink);
+}
+#endif
+
+typedef int (*scan_kernel_fn)(const char *text, size_t text_len,
+                              scan_sink_t *sink);
+
+static scan_kernel_fn scan_kernel = scan_scalar;
+static oast_scan_kernel_t scan_kernel_id = OAST_SCAN_SCALAR;
+
+bool oast_extract_set_kernel(oast_scan_kernel_t kernel) {
+  switch (kernel) {
+  case OAST_SCAN_SCALAR:
+    scan_kernel = scan_scalar;
+    break;
+#if defined(OAST_HAVE_SSE2)
+  case OAST_SCAN_SSE2:
+    scan_kernel = scan_sse2;
+    break;
+#endif
+#if defined(OAST_HAVE_AVX2)
+  case OAST_SCAN_AVX2:
+    if (!oast_cpu_has_avx2()) {
+      return false;
+    }
+    scan_kernel = scan_avx2;
+    break;
+#endif
+  default:
+    return false;
+  }
+  scan_kernel_id = kernel;
+  return true;
+}
 
-      oast_match_t *m = &matches[match_count];
-      m->start_idx = subdomain_start;
-      m->end_idx = domain_end;
-      m->full = text + subdomain_start;
-      m->full_len = domain_end - subdomain_start;
-      m->subdomain = text + subdomain_start;
-      m->subdomain_len = dot_pos - subdomain_start;
-      m->domain = domain; // Points to KNOWN_OAST_DOMAINS entry
+oast_scan_kernel_t oast_extract_get_kernel(void) { return scan_kernel_id; }
 
-      match_count++;
+// Scan text for OAST domains in a single pass, reporting matches in text
+// order. Matches are appended to arena when it is non-NULL; otherwise they
+// are only counted (opts->dedup needs an arena).
+// Stops after limit matches (0 = no limit); opts may lower it.
+// check is oast_extract_kernel(shape).
+// Returns 0 on success, -1 on allocation failure.
+static int scan_matches(const char *text, size_t text_len, oast_shape_t shape,
+                        oast_subdomain_fn check, size_t limit,
+                        const oast_extract_opts_t *opts,
+                        oast_span_arena_t *arena, size_t *match_count_out) {
+  scan_sink_t sink = {arena, 0, limit, check, shape, NULL, NULL};
+  seen_set_t seen;
 
-      // Skip past this match to avoid overlapping matches
-      pos = domain_end - 1; // -1 because loop will increment
+  *match_count_out = 0;
+  if (!automaton.built) {
+    return 0;
+  }
+
+  if (opts) {
+    if (opts->max_matches && (!limit || opts->max_matches < limit)) {
+      sink.limit = opts->max_matches;
     }
+    if (opts->filter_suffixes) {
+      sink.suffix_mask = opts->suffix_mask;
+    }
+    if (opts->dedup && arena) {
+      seen_init(&seen);
+      sink.seen = &seen;
+    }
+  }
+
+  int rc = scan_kernel(text, text_len, &sink);
+  if (sink.seen) {
+    seen_free(sink.seen);
+  }
+  *match_count_out = sink.count;
+  return rc;
+}
+
+bool oast_extract_opts_allow_suffix(oast_extract_opts_t *opts,
+                                    const char *name, size_t name_len) {
+  // The suffix table is lowercase
+  char lower[OAST_MAX_LABEL + 1];
+  if (name_len == 0 || name_len > sizeof(lower)) {
+    return false;
+  }
+  for (size_t i = 0; i < name_len; i++) {
+    lower[i] = (char)tolower((unsigned char)name[i]);
+  }
+
+  int id = oast_match_suffix(lower, name_len);
+  if (id < 0 || oast_suffix_len(id) != name_len ||
+      id >= 64 * OAST_SUFFIX_MASK_WORDS) {
+    return false;
+  }
+  opts->filter_suffixes = true;
+  opts->suffix_mask[id >> 6] |= (uint64_t)1 << (id & 63);
+  return true;
+}
+
+int oast_extract_spans(const char *text, size_t text_len, oast_shape_t shape,
+                       oast_span_arena_t *arena, size_t *appended_out) {
+  return oast_extract_spans_opts(text, text_len, shape, NULL, arena,
+                                 appended_out);
+}
+
+int oast_extract_spans_opts(const char *text, size_t text_len,
+                            oast_shape_t shape,
+                            const oast_extract_opts_t *opts,
+                            oast_span_arena_t *arena, size_t *appended_out) {
+  *appended_out = 0;
+
+  if (text_len == 0 || !text) {
+    return 0;
+  }
+  if (text_len > UINT32_MAX) {
+    return -1;
+  }
+
+  return scan_matches(text, text_len, shape, oast_extract_kernel(shape), 0,
+                      opts, arena, appended_out) < 0
+             ? -1
+             : 0;
+}
+
+int oast_extract(const char *text, size_t text_len, oast_match_t **matches_out,
+                 size_t *match_count_out) {
+  return oast_extract_shape(text, text_len, OAST_SHAPE_DEFAULT, matches_out,
+                            match_count_out);
+}
+
+int oast_extract_shape(const char *text, size_t text_len, oast_shape_t shape,
+                       oast_match_t **matches_out, size_t *match_count_out) {
+  *matches_out = NULL;
+  *match_count_out = 0;
+
+  oast_span_arena_t arena;
+  oast_span_arena_init(&arena);
+
+  size_t match_count = 0;
+  if (oast_extract_spans(text, text_len, shape, &arena, &match_count) != 0) {
+    oast_span_arena_free(&arena);
+    return -1;
+  }
+  if (match_count == 0) {
+    return 0;
+  }
+
+  oast_match_t *matches = malloc(sizeof(oast_match_t) * match_count);
+  if (!matches) {
+    oast_span_arena_free(&arena);
+    return -1;
+  }
+
+  // Expand the compact spans into full matches
+  for (size_t i = 0; i < match_count; i++) {
+    const oast_span_t *span = &arena.spans[i];
+    oast_match_t *m = &matches[i];
+    m->start_idx = span->start;
+    m->end_idx = (size_t)span->start + span->len;
+    m->full = text + span->start;
+    m->full_len = span->len;
+    m->subdomain = m->full;
+    m->subdomain_len = oast_span_subdomain_len(span);
+    m->domain = KNOWN_OAST_DOMAINS[span->suffix_id];
   }
 
+  oast_span_arena_free(&arena);
   *matches_out = matches;
   *match_count_out = match_count;
   return 0;
 }
+
+size_t oast_count_matches(const char *text, size_t text_len, size_t limit) {
+  return oast_count_matches_shape(text, text_len, OAST_SHAPE_DEFAULT, limit);
+}
+
+size_t oast_count_matches_shape(const char *text, size_t text_len,
+                                oast_shape_t shape, size_t limit) {
+  return oast_count_matches_kernel(text, text_len, shape,
+                                   oast_extract_kernel(shape), limit);
+}
+
+size_t oast_count_matches_kernel(const char *text, size_t text_len,
+                                 oast_shape_t shape, oast_subdomain_fn check,
+                                 size_t limit) {
+  size_t match_count = 0;
+
+  if (text_len == 0 || !text) {
+    return 0;
+  }
+
+  // Counting never allocates, so this cannot fail
+  scan_matches(text, text_len, shape, check, limit, NULL, NULL, &match_count);
+  return match_count;
+}
+
+bool oast_has_match(const char *text, size_t text_len) {
+  return oast_count_matches(text, text_len, 1) > 0;
+}
@@ -1,18 +1,234 @@
 #include "oast_functions.h"
 #include "duckdb_extension.h"
+#include "oast_base32.h"
 #include "oast_decode.h"
+#include "oast_domains.h"
+#include "oast_encode.h"
 #include "oast_extract.h"
+#include "oast_simd.h"
 #include "oast_validate.h"
+#include <ctype.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 DUCKDB_EXTENSION_EXTERN
 
-// oast_validate(VARCHAR) -> BOOLEAN
+// Shape arguments (cid_len UTINYINT [, nonce_len UTINYINT]) following the
+// text argument of the shaped overloads. Missing arguments keep the
+// OAST_SHAPE_DEFAULT value.
+typedef struct {
+  uint8_t *cid_len;
+  uint64_t *cid_validity;
+  uint8_t *nonce_len;
+  uint64_t *nonce_validity;
+} oast_shape_args_t;
+
+// first is the column of cid_len (1 unless other arguments precede it)
+static void InitShapeArgs(oast_shape_args_t *args, duckdb_data_chunk input,
+                          idx_t first) {
+  memset(args, 0, sizeof(*args));
+  idx_t columns = duckdb_data_chunk_get_column_count(input);
+  if (columns > first) {
+    duckdb_vector vec = duckdb_data_chunk_get_vector(input, first);
+    args->cid_len = (uint8_t *)duckdb_vector_get_data(vec);
+    args->cid_validity = duckdb_vector_get_validity(vec);
+  }
+  if (columns > first + 1) {
+    duckdb_vector vec = duckdb_data_chunk_get_vector(input, first + 1);
+    args->nonce_len = (uint8_t *)duckdb_vector_get_data(vec);
+    args->nonce_validity = duckdb_vector_get_validity(vec);
+  }
+}
+
+// Shape of row; false if a shape argument is NULL (the row is NULL)
+static bool GetRowShape(const oast_shape_args_t *args, idx_t row,
+                        oast_shape_t *shape) {
+  *shape = OAST_SHAPE_DEFAULT;
+  if (args->cid_len) {
+    if (args->cid_validity &&
+        !duckdb_validity_row_is_valid(args->cid_validity, row)) {
+      return false;
+    }
+    shape->cid_len = args->cid_len[row];
+  }
+  if (args->nonce_len) {
+    if (args->nonce_validity &&
+        !duckdb_validity_row_is_valid(args->nonce_validity, row)) {
+      return false;
+    }
+    shape->nonce_len = args->nonce_len[row];
+  }
+  return true;
+}
+
+static inline bool ShapeEquals(oast_shape_t a, oast_shape_t b) {
+  return a.cid_len == b.cid_len && a.nonce_len == b.nonce_len;
+}
+
+static const char *SHAPE_ERROR = "cid_len must be between 1 and 20";
+
+// Picks the subdomain check a shaped overload applies for a shape
+// (oast_subdomain_kernel or oast_extract_kernel)
+typedef oast_subdomain_fn (*oast_check_resolver_t)(oast_shape_t shape);
+
+// Kernel of a shaped (VARCHAR, cid_len, nonce_len) overload; check is the
+// driver's resolver applied to shape
+typedef void (*oast_shaped_kernel_t)(const char *str, size_t len,
+                                     oast_shape_t shape,
+                                     oast_subdomain_fn check,
+                                     void *output_data, idx_t row);
+
+// Shared driver for the shaped overloads: NULL in any argument gives NULL.
+// The check is resolved again only when the shape changes, so constant
+// shape arguments cost one lookup per chunk.
+static void RunShapedKernel(duckdb_function_info info, duckdb_data_chunk input,
+                            duckdb_vector output, oast_check_resolver_t resolve,
+                            oast_shaped_kernel_t kernel) {
+  idx_t count = duckdb_data_chunk_get_size(input);
+
+  duckdb_vector input_vec = duckdb_data_chunk_get_vector(input, 0);
+  duckdb_string_t *input_data =
+      (duckdb_string_t *)duckdb_vector_get_data(input_vec);
+  uint64_t *input_validity = duckdb_vector_get_validity(input_vec);
+
+  oast_shape_args_t args;
+  InitShapeArgs(&args, input, 1);
+
+  void *output_data = duckdb_vector_get_data(output);
+
+  oast_shape_t current = OAST_SHAPE_DEFAULT;
+  oast_subdomain_fn check = resolve(current);
+
+  for (idx_t row = 0; row < count; row++) {
+    oast_shape_t shape;
+    if ((input_validity &&
+         !duckdb_validity_row_is_valid(input_validity, row)) ||
+        !GetRowShape(&args, row, &shape)) {
+      duckdb_vector_ensure_validity_writable(output);
+      duckdb_validity_set_row_invalid(duckdb_vector_get_validity(output), row);
+      continue;
+    }
+    if (!oast_shape_is_valid(shape)) {
+      duckdb_scalar_function_set_error(info, SHAPE_ERROR);
+      return;
+    }
+    if (!ShapeEquals(shape, current)) {
+      current = shape;
+      check = resolve(shape);
+    }
+
+    duckdb_string_t str = input_data[row];
+    kernel(duckdb_string_t_data(&str), duckdb_string_t_length(str), shape,
+           check, output_data, row);
+  }
+}
+
+static void ValidateShapedKernel(const char *str, size_t len,
+                                 oast_shape_t shape, oast_subdomain_fn check,
+                                 void *output_data, idx_t row) {
+  ((bool *)output_data)[row] = oast_validate_shape(str, len, check, shape);
+}
+
+// oast_validate(VARCHAR, level VARCHAR [, cid_len, nonce_len]) -> BOOLEAN
+// The level is usually constant, so it is parsed again only when a row's
+// level string differs from the last one (compared as the raw string_t:
+// same inline bytes, or same pointer and length). The shape level runs
+// without a context; the others build one, and read the clock, on first use.
+static void ValidateLevelRows(duckdb_function_info info,
+                              duckdb_data_chunk input, duckdb_vector output) {
+  idx_t count = duckdb_data_chunk_get_size(input);
+
+  duckdb_vector input_vec = duckdb_data_chunk_get_vector(input, 0);
+  duckdb_string_t *input_data =
+      (duckdb_string_t *)duckdb_vector_get_data(input_vec);
+  uint64_t *input_validity = duckdb_vector_get_validity(input_vec);
+
+  duckdb_vector level_vec = duckdb_data_chunk_get_vector(input, 1);
+  duckdb_string_t *level_data =
+      (duckdb_string_t *)duckdb_vector_get_data(level_vec);
+  uint64_t *level_validity = duckdb_vector_get_validity(level_vec);
+
+  oast_shape_args_t args;
+  InitShapeArgs(&args, input, 2);
+
+  bool *output_data = (bool *)duckdb_vector_get_data(output);
+
+  duckdb_string_t level_key;
+  bool have_level = false;
+  oast_validate_level_t level = OAST_LEVEL_SHAPE;
+  oast_level_fn kernel = NULL;
+
+  uint32_t now = 0;
+  bool have_ctx = false;
+  oast_validate_ctx_t ctx;
+
+  for (idx_t row = 0; row < count; row++) {
+    oast_shape_t shape;
+    if ((input_validity &&
+         !duckdb_validity_row_is_valid(input_validity, row)) ||
+        (level_validity &&
+         !duckdb_validity_row_is_valid(level_validity, row)) ||
+        !GetRowShape(&args, row, &shape)) {
+      duckdb_vector_ensure_validity_writable(output);
+      duckdb_validity_set_row_invalid(duckdb_vector_get_validity(output), row);
+      continue;
+    }
+    if (!oast_shape_is_valid(shape)) {
+      duckdb_scalar_function_set_error(info, SHAPE_ERROR);
+      return;
+    }
+
+    if (!have_level ||
+        memcmp(&level_data[row], &level_key, sizeof(level_key)) != 0) {
+      if (!oast_validate_level_parse(duckdb_string_t_data(&level_data[row]),
+                                     duckdb_string_t_length(level_data[row]),
+                                     &level)) {
+        duckdb_scalar_function_set_error(
+            info, "level must be 'shape', 'strict' or 'plausible'");
+        return;
+      }
+      level_key = level_data[row];
+      have_level = true;
+      kernel = oast_level_kernel(level);
+    }
+
+    duckdb_string_t str = input_data[row];
+    const char *str_data = duckdb_string_t_data(&str);
+    size_t str_len = duckdb_string_t_length(str);
+
+    if (level == OAST_LEVEL_SHAPE) {
+      output_data[row] = oast_validate_level_shape(str_data, str_len, shape);
+      continue;
+    }
+    if (!have_ctx) {
+      now = (uint32_t)time(NULL);
+      oast_validate_ctx_init(&ctx, shape, now);
+      have_ctx = true;
+    } else if (!ShapeEquals(shape, ctx.shape)) {
+      oast_validate_ctx_init(&ctx, shape, now);
+    }
+    output_data[row] = kernel(str_data, str_len, &ctx);
+  }
+}
+
+// oast_validate(VARCHAR [, level VARCHAR] [, cid_len UTINYINT,
+// nonce_len UTINYINT]) -> BOOLEAN
 static void OASTValidateFunction(duckdb_function_info info,
                                  duckdb_data_chunk input,
                                  duckdb_vector output) {
+  idx_t columns = duckdb_data_chunk_get_column_count(input);
+  if (columns == 2 || columns == 4) {
+    ValidateLevelRows(info, input, output);
+    return;
+  }
+  if (columns == 3) {
+    RunShapedKernel(info, input, output, oast_subdomain_kernel,
+                    ValidateShapedKernel);
+    return;
+  }
+
   idx_t count = duckdb_data_chunk_get_size(input);
 
   // Get input vector (VARCHAR)
@@ -88,10 +304,11 @@ static void OASTDecodeJSONFunction(duckdb_function_info info,
                  result.machine_id[2], result.pid, result.counter, result.ksort,
                  result.campaign, result.nonce);
 
-        if (!result.valid && result.error[0]) {
+        const char *error = oast_decode_error_message(result.error_code);
+        if (!result.valid && error) {
           size_t len = strlen(json);
           snprintf(json + len, sizeof(json) - len, ",\"error\":\"%s\"}",
-                   result.error);
+                   error);
         } else {
           strcat(json, "}");
         }
@@ -122,10 +339,11 @@ static void OASTDecodeJSONFunction(duckdb_function_info info,
                result.machine_id[2], result.pid, result.counter, result.ksort,
                result.campaign, result.nonce);
 
-      if (!result.valid && result.error[0]) {
+      const char *error = oast_decode_error_message(result.error_code);
+      if (!result.valid && error) {
         size_t len = strlen(json);
         snprintf(json + len, sizeof(json) - len, ",\"error\":\"%s\"}",
-                 result.error);
+                 error);
       } else {
         strcat(json, "}");
       }
@@ -135,105 +353,450 @@ static void OASTDecodeJSONFunction(duckdb_function_info info,
   }
 }
 
-// oast_extract(VARCHAR) -> VARCHAR (JSON array of strings)
-static void OASTExtractFunction(duckdb_function_info info,
-                                duckdb_data_chunk input, duckdb_vector output) {
-  idx_t count = duckdb_data_chunk_get_size(input);
+// Fields of a natively decoded OAST STRUCT, in canonical oast_struct() order
+typedef enum {
+  OAST_FIELD_ORIGINAL,
+  OAST_FIELD_VALID,
+  OAST_FIELD_TS,
+  OAST_FIELD_MACHINE_ID,
+  OAST_FIELD_PID,
+  OAST_FIELD_COUNTER,
+  OAST_FIELD_KSORT,
+  OAST_FIELD_CAMPAIGN,
+  OAST_FIELD_NONCE,
+  OAST_FIELD_NONCE_INT,
+  OAST_FIELD_ERROR_CODE,
+  OAST_FIELD_COUNT
+} oast_field_t;
+
+static const char *OAST_FIELD_NAMES[OAST_FIELD_COUNT] = {
+    "original", "valid", "ts",       "machine_id", "pid",       "counter",
+    "ksort",    "campaign", "nonce", "nonce_int",  "error_code"};
+
+static const duckdb_type OAST_FIELD_TYPES[OAST_FIELD_COUNT] = {
+    DUCKDB_TYPE_VARCHAR,  DUCKDB_TYPE_BOOLEAN, DUCKDB_TYPE_BIGINT,
+    DUCKDB_TYPE_VARCHAR,  DUCKDB_TYPE_INTEGER, DUCKDB_TYPE_INTEGER,
+    DUCKDB_TYPE_VARCHAR,  DUCKDB_TYPE_VARCHAR, DUCKDB_TYPE_VARCHAR,
+    DUCKDB_TYPE_UHUGEINT, DUCKDB_TYPE_UTINYINT};
+
+// Ordered subset of fields making up a STRUCT return type
+typedef struct {
+  const oast_field_t *fields;
+  idx_t field_count;
+} oast_struct_layout_t;
+
+static const oast_field_t OAST_DECODE_FIELDS[] = {
+    OAST_FIELD_ORIGINAL, OAST_FIELD_VALID, OAST_FIELD_TS,
+    OAST_FIELD_MACHINE_ID, OAST_FIELD_PID, OAST_FIELD_COUNTER,
+    OAST_FIELD_KSORT, OAST_FIELD_CAMPAIGN, OAST_FIELD_NONCE,
+    OAST_FIELD_NONCE_INT, OAST_FIELD_ERROR_CODE};
+
+static const oast_field_t OAST_SUMMARY_FIELDS[] = {
+    OAST_FIELD_KSORT, OAST_FIELD_CAMPAIGN, OAST_FIELD_MACHINE_ID,
+    OAST_FIELD_TS};
+
+static const oast_struct_layout_t OAST_DECODE_LAYOUT = {
+    OAST_DECODE_FIELDS, sizeof(OAST_DECODE_FIELDS) / sizeof(oast_field_t)};
+
+static const oast_struct_layout_t OAST_SUMMARY_LAYOUT = {
+    OAST_SUMMARY_FIELDS, sizeof(OAST_SUMMARY_FIELDS) / sizeof(oast_field_t)};
+
+// Build the STRUCT logical type for a layout (caller destroys)
+static duckdb_logical_type
+CreateStructType(const oast_struct_layout_t *layout) {
+  duckdb_logical_type member_types[OAST_FIELD_COUNT];
+  const char *member_names[OAST_FIELD_COUNT];
+
+  for (idx_t i = 0; i < layout->field_count; i++) {
+    oast_field_t field = layout->fields[i];
+    member_types[i] = duckdb_create_logical_type(OAST_FIELD_TYPES[field]);
+    member_names[i] = OAST_FIELD_NAMES[field];
+  }
 
-  duckdb_vector input_vec = duckdb_data_chunk_get_vector(input, 0);
-  duckdb_string_t *input_data =
-      (duckdb_string_t *)duckdb_vector_get_data(input_vec);
-  uint64_t *input_validity = duckdb_vector_get_validity(input_vec);
+  duckdb_logical_type type =
+      duckdb_create_struct_type(member_types, member_names, layout->field_count);
 
-  if (input_validity) {
-    duckdb_vector_ensure_validity_writable(output);
-    uint64_t *output_validity = duckdb_vector_get_validity(output);
+  for (idx_t i = 0; i < layout->field_count; i++) {
+    duckdb_destroy_logical_type(&member_types[i]);
+  }
+  return type;
+}
 
-    for (idx_t row = 0; row < count; row++) {
-      if (duckdb_validity_row_is_valid(input_validity, row)) {
-        duckdb_string_t str = input_data[row];
-        const char *str_data = duckdb_string_t_data(&str);
-        size_t str_len = duckdb_string_t_length(str);
+// Child vectors and data pointers of a STRUCT vector, indexed by field.
+// Fields not present in the layout are left NULL and skipped on write.
+typedef struct {
+  duckdb_vector children[OAST_FIELD_COUNT];
+  void *data[OAST_FIELD_COUNT];
+} oast_struct_writer_t;
+
+static void InitStructWriter(oast_struct_writer_t *w, duckdb_vector struct_vec,
+                             const oast_struct_layout_t *layout) {
+  memset(w, 0, sizeof(*w));
+  for (idx_t i = 0; i < layout->field_count; i++) {
+    oast_field_t field = layout->fields[i];
+    w->children[field] = duckdb_struct_vector_get_child(struct_vec, i);
+    w->data[field] = duckdb_vector_get_data(w->children[field]);
+  }
+}
 
-        // Extract matches
-        oast_match_t *matches = NULL;
-        size_t match_count = 0;
-        oast_extract(str_data, str_len, &matches, &match_count);
+static const char HEX_DIGITS[] = "0123456789abcdef";
+
+// Lowercased copy of n bytes of src into the string at row idx
+static void AssignLowerString(duckdb_vector vec, idx_t idx, const char *src,
+                              size_t n) {
+  char buf[OAST_MAX_SUBDOMAIN];
+  for (size_t i = 0; i < n; i++) {
+    buf[i] = (char)tolower((unsigned char)src[i]);
+  }
+  duckdb_vector_assign_string_element_len(vec, idx, buf, n);
+}
 
-        // Build JSON array
-        char json[8192];
-        size_t json_len = 0;
-        json[json_len++] = '[';
+// Mark row idx of one STRUCT child NULL (no-op if the field is not emitted)
+static void SetChildNull(const oast_struct_writer_t *w, oast_field_t field,
+                         idx_t idx) {
+  if (w->children[field]) {
+    duckdb_vector_ensure_validity_writable(w->children[field]);
+    duckdb_validity_set_row_invalid(
+        duckdb_vector_get_validity(w->children[field]), idx);
+  }
+}
 
-        for (size_t i = 0; i < match_count; i++) {
-          if (i > 0) {
-            json[json_len++] = ',';
-          }
-          json[json_len++] = '"';
+// XIDs and nonce lengths of extracted domains, decoded during extraction
+// (see oast_span_arena_init_decoding); element i belongs to ptrs[i]
+typedef struct {
+  const uint64_t *hi;
+  const uint32_t *lo;
+  const uint16_t *nonce_lens;
+} oast_predecoded_t;
+
+// Decode n domains of one shape into rows [base, base + n) of the STRUCT
+// children. Numeric fields are written by oast_decode_batch_shape straight
+// into the child vectors, or taken from pre when the domains were already
+// decoded; string fields are sliced per row from the input. Undecodable
+// rows get zeroed numbers and empty strings. With a truncated correlation
+// id, fields it does not fully cover are NULL.
+static void WriteDecodedBatch(const oast_struct_writer_t *w, idx_t base,
+                              const char **ptrs, const size_t *lens,
+                              const oast_predecoded_t *pre, idx_t n,
+                              oast_shape_t shape) {
+  size_t cid_len = shape.cid_len;
+  uint32_t machine_ids[OAST_DECODE_BATCH_BLOCK];
+  uint16_t nonce_buf[OAST_DECODE_BATCH_BLOCK];
+  uint8_t status[OAST_DECODE_BATCH_BLOCK];
+
+  for (idx_t off = 0; off < n; off += OAST_DECODE_BATCH_BLOCK) {
+    idx_t m = n - off < OAST_DECODE_BATCH_BLOCK ? n - off
+                                                : OAST_DECODE_BATCH_BLOCK;
+    idx_t row = base + off;
+
+    oast_decode_columns_t cols;
+    memset(&cols, 0, sizeof(cols));
+    cols.status = status;
+    if (w->data[OAST_FIELD_TS]) {
+      cols.ts = (int64_t *)w->data[OAST_FIELD_TS] + row;
+    }
+    if (w->children[OAST_FIELD_MACHINE_ID]) {
+      cols.machine_id = machine_ids;
+    }
+    if (w->data[OAST_FIELD_PID]) {
+      cols.pid = (int32_t *)w->data[OAST_FIELD_PID] + row;
+    }
+    if (w->data[OAST_FIELD_COUNTER]) {
+      cols.counter = (int32_t *)w->data[OAST_FIELD_COUNTER] + row;
+    }
+    if (w->data[OAST_FIELD_VALID]) {
+      cols.valid = (bool *)w->data[OAST_FIELD_VALID] + row;
+    }
+    const uint16_t *nonce_lens = nonce_buf;
+    if (pre) {
+      oast_decode_xid_columns(pre->hi + off, pre->lo + off, m, &cols);
+      memset(status, OAST_DECODE_OK, m);
+      if (cols.valid) {
+        memset(cols.valid, true, m);
+      }
+      nonce_lens = pre->nonce_lens + off;
+    } else {
+      cols.nonce_len = nonce_buf;
+      oast_decode_batch_shape(ptrs + off, lens + off, m, shape, &cols);
+    }
 
-          // Copy full domain (subdomain.domain)
-          size_t copy_len = matches[i].full_len;
-          if (json_len + copy_len + 2 < sizeof(json)) {
-            memcpy(json + json_len, matches[i].full, copy_len);
-            json_len += copy_len;
+    if (w->data[OAST_FIELD_ERROR_CODE]) {
+      memcpy((uint8_t *)w->data[OAST_FIELD_ERROR_CODE] + row, status, m);
+    }
+
+    for (idx_t i = 0; i < m; i++) {
+      const char *original = ptrs[off + i];
+      bool ok = status[i] == OAST_DECODE_OK;
+
+      if (w->children[OAST_FIELD_ORIGINAL]) {
+        duckdb_vector_assign_string_element_len(
+            w->children[OAST_FIELD_ORIGINAL], row + i, original,
+            lens[off + i]);
+      }
+      if (w->children[OAST_FIELD_MACHINE_ID]) {
+        // "xx:xx:xx" without going through snprintf
+        char mid[8];
+        for (int b = 0; b < 3; b++) {
+          uint8_t byte = (uint8_t)(machine_ids[i] >> (16 - 8 * b));
+          mid[b * 3] = HEX_DIGITS[byte >> 4];
+          mid[b * 3 + 1] = HEX_DIGITS[byte & 0x0F];
+          if (b < 2) {
+            mid[b * 3 + 2] = ':';
           }
+        }
+        duckdb_vector_assign_string_element_len(
+            w->children[OAST_FIELD_MACHINE_ID], row + i, mid, sizeof(mid));
+      }
+      if (w->children[OAST_FIELD_KSORT]) {
+        AssignLowerString(w->children[OAST_FIELD_KSORT], row + i, original,
+                          ok && cid_len >= OAST_CID_CHARS_KSORT ? 6 : 0);
+      }
+      if (w->children[OAST_FIELD_CAMPAIGN]) {
+        AssignLowerString(w->children[OAST_FIELD_CAMPAIGN], row + i,
+                          original + 6,
+                          ok && cid_len >= OAST_CID_CHARS_CAMPAIGN ? 5 : 0);
+      }
+      if (w->children[OAST_FIELD_NONCE]) {
+        AssignLowerString(w->children[OAST_FIELD_NONCE], row + i,
+                          original + cid_len, nonce_lens[i]);
+      }
+      if (w->data[OAST_FIELD_NONCE_INT]) {
+        duckdb_uhugeint *nonce_int =
+            &((duckdb_uhugeint *)w->data[OAST_FIELD_NONCE_INT])[row + i];
+        if (!ok || !zbase32_decode_bits(original + cid_len, nonce_lens[i],
+                                        &nonce_int->upper,
+                                        &nonce_int->lower)) {
+          duckdb_vector_ensure_validity_writable(
+              w->children[OAST_FIELD_NONCE_INT]);
+          duckdb_validity_set_row_invalid(
+              duckdb_vector_get_validity(w->children[OAST_FIELD_NONCE_INT]),
+              row + i);
+        }
+      }
+    }
 
-          json[json_len++] = '"';
+    if (cid_len < OAST_CID_LEN) {
+      static const struct {
+        oast_field_t field;
+        size_t cid_chars;
+      } coverage[] = {{OAST_FIELD_TS, OAST_CID_CHARS_TS},
+                      {OAST_FIELD_MACHINE_ID, OAST_CID_CHARS_MACHINE_ID},
+                      {OAST_FIELD_PID, OAST_CID_CHARS_PID},
+                      {OAST_FIELD_COUNTER, OAST_CID_CHARS_COUNTER},
+                      {OAST_FIELD_KSORT, OAST_CID_CHARS_KSORT},
+                      {OAST_FIELD_CAMPAIGN, OAST_CID_CHARS_CAMPAIGN}};
+      for (size_t c = 0; c < sizeof(coverage) / sizeof(coverage[0]); c++) {
+        if (cid_len >= coverage[c].cid_chars) {
+          continue;
+        }
+        for (idx_t i = 0; i < m; i++) {
+          if (status[i] == OAST_DECODE_OK) {
+            SetChildNull(w, coverage[c].field, row + i);
+          }
         }
+      }
+    }
+  }
+}
+
+// Mark row idx NULL in the STRUCT and in every child
+static void SetStructRowNull(duckdb_vector struct_vec,
+                             const oast_struct_writer_t *w, idx_t idx) {
+  duckdb_vector_ensure_validity_writable(struct_vec);
+  duckdb_validity_set_row_invalid(duckdb_vector_get_validity(struct_vec), idx);
 
-        json[json_len++] = ']';
-        json[json_len] = '\0';
+  for (int f = 0; f < OAST_FIELD_COUNT; f++) {
+    SetChildNull(w, (oast_field_t)f, idx);
+  }
+}
 
-        duckdb_vector_assign_string_element_len(output, row, json, json_len);
+// oast_decode(VARCHAR [, cid_len UTINYINT]) -> STRUCT
+// oast_summary(VARCHAR [, cid_len UTINYINT]) -> STRUCT
+// Decodes straight into the STRUCT child vectors; the layout (extra info)
+// selects which fields are emitted.
+static void OASTDecodeStructFunction(duckdb_function_info info,
+                                     duckdb_data_chunk input,
+                                     duckdb_vector output) {
+  const oast_struct_layout_t *layout =
+      (const oast_struct_layout_t *)duckdb_scalar_function_get_extra_info(info);
+  idx_t count = duckdb_data_chunk_get_size(input);
 
-        free(matches);
-      } else {
-        duckdb_validity_set_row_invalid(output_validity, row);
+  duckdb_vector input_vec = duckdb_data_chunk_get_vector(input, 0);
+  duckdb_string_t *input_data =
+      (duckdb_string_t *)duckdb_vector_get_data(input_vec);
+  uint64_t *input_validity = duckdb_vector_get_validity(input_vec);
+
+  oast_shape_args_t args;
+  InitShapeArgs(&args, input, 1);
+
+  oast_struct_writer_t writer;
+  InitStructWriter(&writer, output, layout);
+
+  // Decode in blocks of one shape; NULL rows decode as empty input and are
+  // masked after
+  const char *ptrs[OAST_DECODE_BATCH_BLOCK];
+  size_t lens[OAST_DECODE_BATCH_BLOCK];
+  bool any_null = false;
+  idx_t row = 0;
+  while (row < count) {
+    idx_t base = row;
+    idx_t m = 0;
+    bool has_shape = false;
+    oast_shape_t block_shape = OAST_SHAPE_DEFAULT;
+
+    for (; row < count && m < OAST_DECODE_BATCH_BLOCK; row++, m++) {
+      oast_shape_t shape;
+      if ((input_validity &&
+           !duckdb_validity_row_is_valid(input_validity, row)) ||
+          !GetRowShape(&args, row, &shape)) {
+        any_null = true;
+        ptrs[m] = "";
+        lens[m] = 0;
+        continue;
+      }
+      if (!oast_shape_is_valid(shape)) {
+        duckdb_scalar_function_set_error(info, SHAPE_ERROR);
+        return;
       }
+      if (has_shape && !ShapeEquals(shape, block_shape)) {
+        break;
+      }
+      has_shape = true;
+      block_shape = shape;
+      ptrs[m] = duckdb_string_t_data(&input_data[row]);
+      lens[m] = duckdb_string_t_length(input_data[row]);
     }
-  } else {
-    for (idx_t row = 0; row < count; row++) {
-      duckdb_string_t str = input_data[row];
-      const char *str_data = duckdb_string_t_data(&str);
-      size_t str_len = duckdb_string_t_length(str);
+    WriteDecodedBatch(&writer, base, ptrs, lens, NULL, m, block_shape);
+  }
 
-      oast_match_t *matches = NULL;
-      size_t match_count = 0;
-      oast_extract(str_data, str_len, &matches, &match_count);
+  if (any_null) {
+    for (row = 0; row < count; row++) {
+      oast_shape_t shape;
+      if ((input_validity &&
+           !duckdb_validity_row_is_valid(input_validity, row)) ||
+          !GetRowShape(&args, row, &shape)) {
+        SetStructRowNull(output, &writer, row);
+      }
+    }
+  }
+}
 
-      char json[8192];
-      size_t json_len = 0;
-      json[json_len++] = '[';
+// Single-field kernel: decode one field of one domain into row of output.
+// Returns false if the domain does not decode (row becomes NULL).
+typedef bool (*oast_field_kernel_t)(const char *str, size_t len,
+                                    duckdb_vector output, void *output_data,
+                                    idx_t row);
+
+// The subdomain length check oast_decode applies before the preamble, so
+// the accessors are NULL exactly where oast_decode reports an error
+static inline bool SubdomainFits(const char *str, size_t len) {
+  const char *dot = memchr(str, '.', len);
+  return (dot ? (size_t)(dot - str) : len) <= 255;
+}
 
-      for (size_t i = 0; i < match_count; i++) {
-        if (i > 0) {
-          json[json_len++] = ',';
-        }
-        json[json_len++] = '"';
+// XID of str under the same acceptance rules as oast_decode
+static inline bool DecodeXid(const char *str, size_t len, oast_xid_t *xid) {
+  return SubdomainFits(str, len) && oast_decode_preamble(str, len, xid) == 0;
+}
 
-        size_t copy_len = matches[i].full_len;
-        if (json_len + copy_len + 2 < sizeof(json)) {
-          memcpy(json + json_len, matches[i].full, copy_len);
-          json_len += copy_len;
-        }
+static bool TimestampKernel(const char *str, size_t len, duckdb_vector output,
+                            void *output_data, idx_t row) {
+  oast_xid_t xid;
+  if (!DecodeXid(str, len, &xid)) {
+    return false;
+  }
+  ((duckdb_timestamp *)output_data)[row].micros =
+      (int64_t)oast_xid_timestamp(&xid) * 1000000;
+  return true;
+}
 
-        json[json_len++] = '"';
-      }
+static bool MachineIdKernel(const char *str, size_t len, duckdb_vector output,
+                            void *output_data, idx_t row) {
+  oast_xid_t xid;
+  if (!DecodeXid(str, len, &xid)) {
+    return false;
+  }
+  ((uint32_t *)output_data)[row] = oast_xid_machine_id(&xid);
+  return true;
+}
 
-      json[json_len++] = ']';
-      json[json_len] = '\0';
+static bool PidKernel(const char *str, size_t len, duckdb_vector output,
+                      void *output_data, idx_t row) {
+  oast_xid_t xid;
+  if (!DecodeXid(str, len, &xid)) {
+    return false;
+  }
+  ((uint16_t *)output_data)[row] = oast_xid_pid(&xid);
+  return true;
+}
 
-      duckdb_vector_assign_string_element_len(output, row, json, json_len);
+static bool CounterKernel(const char *str, size_t len, duckdb_vector output,
+                          void *output_data, idx_t row) {
+  oast_xid_t xid;
+  if (!DecodeXid(str, len, &xid)) {
+    return false;
+  }
+  ((uint32_t *)output_data)[row] = oast_xid_counter(&xid);
+  return true;
+}
 
-      free(matches);
-    }
+// Timestamp from the first 7 chars only; nothing else is validated
+static bool TsFastKernel(const char *str, size_t len, duckdb_vector output,
+                         void *output_data, idx_t row) {
+  uint32_t ts;
+  if (oast_decode_ts_prefix(str, len, &ts) != 0) {
+    return false;
   }
+  ((duckdb_timestamp *)output_data)[row].micros = (int64_t)ts * 1000000;
+  return true;
 }
 
-// oast_extract_decode(VARCHAR) -> VARCHAR (JSON array of decoded objects)
-static void OASTExtractDecodeFunction(duckdb_function_info info,
-                                      duckdb_data_chunk input,
-                                      duckdb_vector output) {
+// Same, but only for input that passes oast_validate
+static bool TsStrictKernel(const char *str, size_t len, duckdb_vector output,
+                           void *output_data, idx_t row) {
+  if (!oast_validate(str, len)) {
+    return false;
+  }
+  return TsFastKernel(str, len, output, output_data, row);
+}
+
+static bool NonceIntKernel(const char *str, size_t len, duckdb_vector output,
+                           void *output_data, idx_t row) {
+  duckdb_uhugeint *value = &((duckdb_uhugeint *)output_data)[row];
+  return oast_decode_nonce_int(str, len, &value->upper, &value->lower) == 0;
+}
+
+// Lowercased slice [offset, offset + n) of the preamble of a domain that
+// oast_decode accepts (no decode)
+static bool PreambleSliceKernel(const char *str, size_t len,
+                                duckdb_vector output, idx_t row, size_t offset,
+                                size_t n) {
+  if (len < 20 || !oast_is_valid_preamble(str, 20) ||
+      !SubdomainFits(str, len)) {
+    return false;
+  }
+  char buf[20];
+  for (size_t i = 0; i < n; i++) {
+    buf[i] = (char)tolower((unsigned char)str[offset + i]);
+  }
+  duckdb_vector_assign_string_element_len(output, row, buf, n);
+  return true;
+}
+
+static bool KsortKernel(const char *str, size_t len, duckdb_vector output,
+                        void *output_data, idx_t row) {
+  return PreambleSliceKernel(str, len, output, row, 0, 6);
+}
+
+static bool CampaignKernel(const char *str, size_t len, duckdb_vector output,
+                           void *output_data, idx_t row) {
+  return PreambleSliceKernel(str, len, output, row, 6, 5);
+}
+
+// Shared driver for the single-field accessors: NULL in, NULL out; rows
+// that fail to decode are NULL as well.
+static inline void RunFieldKernel(duckdb_data_chunk input, duckdb_vector output,
+                                  oast_field_kernel_t kernel) {
   idx_t count = duckdb_data_chunk_get_size(input);
 
   duckdb_vector input_vec = duckdb_data_chunk_get_vector(input, 0);
@@ -241,162 +804,1172 @@ static void OASTExtractDecodeFunction(duckdb_function_info info,
       (duckdb_string_t *)duckdb_vector_get_data(input_vec);
   uint64_t *input_validity = duckdb_vector_get_validity(input_vec);
 
-  if (input_validity) {
-    duckdb_vector_ensure_validity_writable(output);
-    uint64_t *output_validity = duckdb_vector_get_validity(output);
+  void *output_data = duckdb_vector_get_data(output);
+  duckdb_vector_ensure_validity_writable(output);
+  uint64_t *output_validity = duckdb_vector_get_validity(output);
 
-    for (idx_t row = 0; row < count; row++) {
-      if (duckdb_validity_row_is_valid(input_validity, row)) {
-        duckdb_string_t str = input_data[row];
-        const char *str_data = duckdb_string_t_data(&str);
-        size_t str_len = duckdb_string_t_length(str);
+  for (idx_t row = 0; row < count; row++) {
+    if (input_validity && !duckdb_validity_row_is_valid(input_validity, row)) {
+      duckdb_validity_set_row_invalid(output_validity, row);
+      continue;
+    }
 
-        // Extract matches
-        oast_match_t *matches = NULL;
-        size_t match_count = 0;
-        oast_extract(str_data, str_len, &matches, &match_count);
+    duckdb_string_t str = input_data[row];
+    const char *str_data = duckdb_string_t_data(&str);
+    size_t str_len = duckdb_string_t_length(str);
 
-        // Build JSON array of decoded objects
-        char *json = malloc(16384);
-        if (!json) {
-          duckdb_validity_set_row_invalid(output_validity, row);
-          free(matches);
-          continue;
-        }
+    if (!kernel(str_data, str_len, output, output_data, row)) {
+      duckdb_validity_set_row_invalid(output_validity, row);
+    }
+  }
+}
 
-        size_t json_len = 0;
-        json[json_len++] = '[';
+// oast_timestamp(VARCHAR) -> TIMESTAMP WITH TIME ZONE
+static void OASTTimestampFunction(duckdb_function_info info,
+                                  duckdb_data_chunk input,
+                                  duckdb_vector output) {
+  RunFieldKernel(input, output, TimestampKernel);
+}
 
-        for (size_t i = 0; i < match_count; i++) {
-          if (i > 0 && json_len < 16383) {
-            json[json_len++] = ',';
-          }
+// oast_machine_id(VARCHAR) -> UINTEGER
+static void OASTMachineIdFunction(duckdb_function_info info,
+                                  duckdb_data_chunk input,
+                                  duckdb_vector output) {
+  RunFieldKernel(input, output, MachineIdKernel);
+}
 
-          // Decode this match
-          oast_decoded_t decoded;
-          oast_decode(matches[i].full, matches[i].full_len, &decoded);
-
-          // Append decoded JSON
-          size_t remaining = 16384 - json_len;
-          if (remaining < 2)
-            break; // Need at least room for "]" and null terminator
-
-          int written = snprintf(
-              json + json_len, remaining,
-              "{\"original\":\"%.*s\",\"valid\":%s,\"ts\":%u,"
-              "\"machine_id\":\"%02x:%02x:%02x\",\"pid\":%u,\"counter\":%u,"
-              "\"ksort\":\"%s\",\"campaign\":\"%s\",\"nonce\":\"%s\"}",
-              (int)matches[i].full_len, matches[i].full,
-              decoded.valid ? "true" : "false", decoded.timestamp,
-              decoded.machine_id[0], decoded.machine_id[1],
-              decoded.machine_id[2], decoded.pid, decoded.counter,
-              decoded.ksort, decoded.campaign, decoded.nonce);
-
-          // Check if snprintf succeeded and didn't truncate
-          if (written > 0 && (size_t)written < remaining) {
-            json_len += written;
-          } else {
-            // Output was truncated, stop adding more entries
-            break;
-          }
-        }
+// oast_pid(VARCHAR) -> USMALLINT
+static void OASTPidFunction(duckdb_function_info info, duckdb_data_chunk input,
+                            duckdb_vector output) {
+  RunFieldKernel(input, output, PidKernel);
+}
 
-        if (json_len < 16383) {
-          json[json_len++] = ']';
-        }
-        if (json_len < 16384) {
-          json[json_len] = '\0';
-        }
+// oast_counter(VARCHAR) -> UINTEGER
+static void OASTCounterFunction(duckdb_function_info info,
+                                duckdb_data_chunk input, duckdb_vector output) {
+  RunFieldKernel(input, output, CounterKernel);
+}
 
-        duckdb_vector_assign_string_element_len(output, row, json, json_len);
+// oast_ksort(VARCHAR) -> VARCHAR
+static void OASTKsortFunction(duckdb_function_info info,
+                              duckdb_data_chunk input, duckdb_vector output) {
+  RunFieldKernel(input, output, KsortKernel);
+}
 
-        free(json);
-        free(matches);
-      } else {
-        duckdb_validity_set_row_invalid(output_validity, row);
-      }
-    }
-  } else {
-    for (idx_t row = 0; row < count; row++) {
-      duckdb_string_t str = input_data[row];
-      const char *str_data = duckdb_string_t_data(&str);
-      size_t str_len = duckdb_string_t_length(str);
+// oast_campaign(VARCHAR) -> VARCHAR
+static void OASTCampaignFunction(duckdb_function_info info,
+                                 duckdb_data_chunk input,
+                                 duckdb_vector output) {
+  RunFieldKernel(input, output, CampaignKernel);
+}
 
-      oast_match_t *matches = NULL;
-      size_t match_count = 0;
-      oast_extract(str_data, str_len, &matches, &match_count);
+// oast_nonce_int(VARCHAR) -> UHUGEINT
+static void OASTNonceIntFunction(duckdb_function_info info,
+                                 duckdb_data_chunk input,
+                                 duckdb_vector output) {
+  RunFieldKernel(input, output, NonceIntKernel);
+}
 
-      char *json = malloc(16384);
-      if (!json) {
-        free(matches);
-        continue;
-      }
+// oast_ts_fast(VARCHAR [, strict BOOLEAN]) -> TIMESTAMP
+// Without strict (or strict = false) only the 7 timestamp chars are decoded;
+// strict = true requires the whole domain to pass oast_validate first.
+static void OASTTsFastFunction(duckdb_function_info info,
+                               duckdb_data_chunk input, duckdb_vector output) {
+  if (duckdb_data_chunk_get_column_count(input) < 2) {
+    RunFieldKernel(input, output, TsFastKernel);
+    return;
+  }
 
-      size_t json_len = 0;
-      json[json_len++] = '[';
+  idx_t count = duckdb_data_chunk_get_size(input);
 
-      for (size_t i = 0; i < match_count; i++) {
-        if (i > 0 && json_len < 16383) {
-          json[json_len++] = ',';
-        }
+  duckdb_vector input_vec = duckdb_data_chunk_get_vector(input, 0);
+  duckdb_string_t *input_data =
+      (duckdb_string_t *)duckdb_vector_get_data(input_vec);
+  uint64_t *input_validity = duckdb_vector_get_validity(input_vec);
 
-        oast_decoded_t decoded;
-        oast_decode(matches[i].full, matches[i].full_len, &decoded);
-
-        size_t remaining = 16384 - json_len;
-        if (remaining < 2)
-          break; // Need at least room for "]" and null terminator
-
-        int written = snprintf(
-            json + json_len, remaining,
-            "{\"original\":\"%.*s\",\"valid\":%s,\"ts\":%u,"
-            "\"machine_id\":\"%02x:%02x:%02x\",\"pid\":%u,\"counter\":%u,"
-            "\"ksort\":\"%s\",\"campaign\":\"%s\",\"nonce\":\"%s\"}",
-            (int)matches[i].full_len, matches[i].full,
-            decoded.valid ? "true" : "false", decoded.timestamp,
-            decoded.machine_id[0], decoded.machine_id[1], decoded.machine_id[2],
-            decoded.pid, decoded.counter, decoded.ksort, decoded.campaign,
-            decoded.nonce);
-
-        // Check if snprintf succeeded and didn't truncate
-        if (written > 0 && (size_t)written < remaining) {
-          json_len += written;
-        } else {
-          // Output was truncated, stop adding more entries
-          break;
-        }
-      }
+  duckdb_vector strict_vec = duckdb_data_chunk_get_vector(input, 1);
+  bool *strict_data = (bool *)duckdb_vector_get_data(strict_vec);
+  uint64_t *strict_validity = duckdb_vector_get_validity(strict_vec);
+
+  void *output_data = duckdb_vector_get_data(output);
+  duckdb_vector_ensure_validity_writable(output);
+  uint64_t *output_validity = duckdb_vector_get_validity(output);
+
+  for (idx_t row = 0; row < count; row++) {
+    if ((input_validity &&
+         !duckdb_validity_row_is_valid(input_validity, row)) ||
+        (strict_validity &&
+         !duckdb_validity_row_is_valid(strict_validity, row))) {
+      duckdb_validity_set_row_invalid(output_validity, row);
+      continue;
+    }
 
-      if (json_len < 16383) {
-        json[json_len++] = ']';
-      }
-      if (json_len < 16384) {
-        json[json_len] = '\0';
+    duckdb_string_t str = input_data[row];
+    const char *str_data = duckdb_string_t_data(&str);
+    size_t str_len = duckdb_string_t_length(str);
+
+    oast_field_kernel_t kernel =
+        strict_data[row] ? TsStrictKernel : TsFastKernel;
+    if (!kernel(str_data, str_len, output, output_data, row)) {
+      duckdb_validity_set_row_invalid(output_validity, row);
+    }
+  }
+}
+
+// Whole seconds of a TIMESTAMP clamped to the uint32 XID range
+static uint32_t TimestampToXidSeconds(duckdb_timestamp ts) {
+  int64_t secs = ts.micros / 1000000;
+  if (ts.micros % 1000000 < 0) {
+    secs--; // floor for pre-epoch values
+  }
+  if (secs < 0) {
+    return 0;
+  }
+  if (secs > (int64_t)UINT32_MAX) {
+    return UINT32_MAX;
+  }
+  return (uint32_t)secs;
+}
+
+// oast_ts_prefix_range(TIMESTAMP, TIMESTAMP) -> STRUCT(lo VARCHAR, hi VARCHAR)
+// Domain bounds for a time window, for `domain BETWEEN lo AND hi` filters
+// that DuckDB can check against min/max zonemaps
+static void OASTTsPrefixRangeFunction(duckdb_function_info info,
+                                      duckdb_data_chunk input,
+                                      duckdb_vector output) {
+  idx_t count = duckdb_data_chunk_get_size(input);
+
+  duckdb_vector lo_vec = duckdb_data_chunk_get_vector(input, 0);
+  duckdb_vector hi_vec = duckdb_data_chunk_get_vector(input, 1);
+  duckdb_timestamp *lo_data = (duckdb_timestamp *)duckdb_vector_get_data(lo_vec);
+  duckdb_timestamp *hi_data = (duckdb_timestamp *)duckdb_vector_get_data(hi_vec);
+  uint64_t *lo_validity = duckdb_vector_get_validity(lo_vec);
+  uint64_t *hi_validity = duckdb_vector_get_validity(hi_vec);
+
+  duckdb_vector lo_out = duckdb_struct_vector_get_child(output, 0);
+  duckdb_vector hi_out = duckdb_struct_vector_get_child(output, 1);
+
+  for (idx_t row = 0; row < count; row++) {
+    if ((lo_validity && !duckdb_validity_row_is_valid(lo_validity, row)) ||
+        (hi_validity && !duckdb_validity_row_is_valid(hi_validity, row))) {
+      duckdb_vector children[2] = {lo_out, hi_out};
+      duckdb_vector_ensure_validity_writable(output);
+      duckdb_validity_set_row_invalid(duckdb_vector_get_validity(output), row);
+      for (int i = 0; i < 2; i++) {
+        duckdb_vector_ensure_validity_writable(children[i]);
+        duckdb_validity_set_row_invalid(
+            duckdb_vector_get_validity(children[i]), row);
       }
+      continue;
+    }
 
-      duckdb_vector_assign_string_element_len(output, row, json, json_len);
+    char lo[OAST_TS_PREFIX_LEN];
+    char hi[OAST_TS_PREFIX_LEN + 1];
+    oast_ts_prefix_bounds(TimestampToXidSeconds(lo_data[row]),
+                          TimestampToXidSeconds(hi_data[row]), lo, hi);
+    duckdb_vector_assign_string_element_len(lo_out, row, lo, sizeof(lo));
+    duckdb_vector_assign_string_element_len(hi_out, row, hi, sizeof(hi));
+  }
+}
 
-      free(json);
-      free(matches);
+// Byte-wise comparison of lower(a) against b (b is already lowercase)
+static int CompareLower(const char *a, size_t a_len, const char *b,
+                        size_t b_len) {
+  size_t n = a_len < b_len ? a_len : b_len;
+  for (size_t i = 0; i < n; i++) {
+    unsigned char ca = (unsigned char)tolower((unsigned char)a[i]);
+    unsigned char cb = (unsigned char)b[i];
+    if (ca != cb) {
+      return ca < cb ? -1 : 1;
     }
   }
+  return a_len < b_len ? -1 : (a_len > b_len ? 1 : 0);
 }
 
-void RegisterOASTFunctions(duckdb_connection connection) {
-  duckdb_logical_type varchar_type =
-      duckdb_create_logical_type(DUCKDB_TYPE_VARCHAR);
-  duckdb_logical_type bool_type =
-      duckdb_create_logical_type(DUCKDB_TYPE_BOOLEAN);
+// oast_in_prefix_range(domain VARCHAR, lo VARCHAR, hi VARCHAR) -> BOOLEAN
+// lo <= lower(domain) <= hi, without lowercasing into a copy or decoding
+static void OASTInPrefixRangeFunction(duckdb_function_info info,
+                                      duckdb_data_chunk input,
+                                      duckdb_vector output) {
+  idx_t count = duckdb_data_chunk_get_size(input);
 
-  // Register oast_validate(VARCHAR) -> BOOLEAN
-  {
-    duckdb_scalar_function function = duckdb_create_scalar_function();
-    duckdb_scalar_function_set_name(function, "oast_validate");
-    duckdb_scalar_function_add_parameter(function, varchar_type);
-    duckdb_scalar_function_set_return_type(function, bool_type);
-    duckdb_scalar_function_set_function(function, OASTValidateFunction);
-    duckdb_register_scalar_function(connection, function);
-    duckdb_destroy_scalar_function(&function);
+  duckdb_string_t *data[3];
+  uint64_t *validity[3];
+  for (idx_t col = 0; col < 3; col++) {
+    duckdb_vector vec = duckdb_data_chunk_get_vector(input, col);
+    data[col] = (duckdb_string_t *)duckdb_vector_get_data(vec);
+    validity[col] = duckdb_vector_get_validity(vec);
+  }
+
+  bool *output_data = (bool *)duckdb_vector_get_data(output);
+
+  for (idx_t row = 0; row < count; row++) {
+    bool is_null = false;
+    for (idx_t col = 0; col < 3; col++) {
+      if (validity[col] && !duckdb_validity_row_is_valid(validity[col], row)) {
+        is_null = true;
+      }
+    }
+    if (is_null) {
+      duckdb_vector_ensure_validity_writable(output);
+      duckdb_validity_set_row_invalid(duckdb_vector_get_validity(output), row);
+      continue;
+    }
+
+    duckdb_string_t *domain = &data[0][row];
+    duckdb_string_t *lo = &data[1][row];
+    duckdb_string_t *hi = &data[2][row];
+    const char *d = duckdb_string_t_data(domain);
+    size_t d_len = duckdb_string_t_length(*domain);
+
+    output_data[row] =
+        CompareLower(d, d_len, duckdb_string_t_data(lo),
+                     duckdb_string_t_length(*lo)) >= 0 &&
+        CompareLower(d, d_len, duckdb_string_t_data(hi),
+                     duckdb_string_t_length(*hi)) <= 0;
+  }
+}
+
+static bool CountKernel(const char *str, size_t len, duckdb_vector output,
+                        void *output_data, idx_t row) {
+  ((int64_t *)output_data)[row] = (int64_t)oast_count_matches(str, len, 0);
+  return true;
+}
+
+static bool HasOASTKernel(const char *str, size_t len, duckdb_vector output,
+                          void *output_data, idx_t row) {
+  ((bool *)output_data)[row] = oast_has_match(str, len);
+  return true;
+}
+
+static void CountShapedKernel(const char *str, size_t len, oast_shape_t shape,
+                              oast_subdomain_fn check, void *output_data,
+                              idx_t row) {
+  ((int64_t *)output_data)[row] =
+      (int64_t)oast_count_matches_kernel(str, len, shape, check, 0);
+}
+
+static void HasOASTShapedKernel(const char *str, size_t len,
+                                oast_shape_t shape, oast_subdomain_fn check,
+                                void *output_data, idx_t row) {
+  ((bool *)output_data)[row] =
+      oast_count_matches_kernel(str, len, shape, check, 1) > 0;
+}
+
+// oast_count(VARCHAR [, cid_len UTINYINT, nonce_len UTINYINT]) -> BIGINT
+static void OASTCountFunction(duckdb_function_info info,
+                              duckdb_data_chunk input, duckdb_vector output) {
+  if (duckdb_data_chunk_get_column_count(input) > 1) {
+    RunShapedKernel(info, input, output, oast_extract_kernel,
+                    CountShapedKernel);
+    return;
+  }
+  RunFieldKernel(input, output, CountKernel);
+}
+
+// oast_has_oast(VARCHAR [, cid_len UTINYINT, nonce_len UTINYINT]) -> BOOLEAN
+static void OASTHasOASTFunction(duckdb_function_info info,
+                                duckdb_data_chunk input, duckdb_vector output) {
+  if (duckdb_data_chunk_get_column_count(input) > 1) {
+    RunShapedKernel(info, input, output, oast_extract_kernel,
+                    HasOASTShapedKernel);
+    return;
+  }
+  RunFieldKernel(input, output, HasOASTKernel);
+}
+
+// Assign a JSON array of the matched domains to row of output. The array is
+// sized exactly from the match lengths, spilling to the heap when it does
+// not fit the stack buffer. Returns false on allocation failure.
+static bool AssignMatchesJSON(duckdb_vector output, idx_t row,
+                              const char *text, const oast_span_t *spans,
+                              size_t match_count) {
+  size_t needed = 2; // [ ]
+  for (size_t i = 0; i < match_count; i++) {
+    needed += spans[i].len + 3; // quotes + comma
+  }
+
+  char stack_json[8192];
+  char *json = needed <= sizeof(stack_json) ? stack_json : malloc(needed);
+  if (!json) {
+    return false;
+  }
+
+  size_t json_len = 0;
+  json[json_len++] = '[';
+
+  for (size_t i = 0; i < match_count; i++) {
+    if (i > 0) {
+      json[json_len++] = ',';
+    }
+    json[json_len++] = '"';
+
+    // Copy full domain (subdomain.domain)
+    memcpy(json + json_len, text + spans[i].start, spans[i].len);
+    json_len += spans[i].len;
+
+    json[json_len++] = '"';
+  }
+
+  json[json_len++] = ']';
+
+  duckdb_vector_assign_string_element_len(output, row, json, json_len);
+
+  if (json != stack_json) {
+    free(json);
+  }
+  return true;
+}
+
+// oast_extract(text, max_matches UINTEGER, dedup BOOLEAN, suffixes
+// VARCHAR[]) -> VARCHAR. NULL options mean the default (all matches, keep
+// repeats, every suffix). The options are usually constant, so the suffix
+// filter is only rebuilt when a row's list entry differs from the last one.
+static void ExtractOptionsRows(duckdb_function_info info,
+                               duckdb_data_chunk input, duckdb_vector output) {
+  idx_t count = duckdb_data_chunk_get_size(input);
+
+  duckdb_vector input_vec = duckdb_data_chunk_get_vector(input, 0);
+  duckdb_string_t *input_data =
+      (duckdb_string_t *)duckdb_vector_get_data(input_vec);
+  uint64_t *input_validity = duckdb_vector_get_validity(input_vec);
+
+  duckdb_vector max_vec = duckdb_data_chunk_get_vector(input, 1);
+  uint32_t *max_data = (uint32_t *)duckdb_vector_get_data(max_vec);
+  uint64_t *max_validity = duckdb_vector_get_validity(max_vec);
+
+  duckdb_vector dedup_vec = duckdb_data_chunk_get_vector(input, 2);
+  bool *dedup_data = (bool *)duckdb_vector_get_data(dedup_vec);
+  uint64_t *dedup_validity = duckdb_vector_get_validity(dedup_vec);
+
+  duckdb_vector suffix_vec = duckdb_data_chunk_get_vector(input, 3);
+  duckdb_list_entry *suffix_entries =
+      (duckdb_list_entry *)duckdb_vector_get_data(suffix_vec);
+  uint64_t *suffix_validity = duckdb_vector_get_validity(suffix_vec);
+  duckdb_vector names_vec = duckdb_list_vector_get_child(suffix_vec);
+  duckdb_string_t *names = (duckdb_string_t *)duckdb_vector_get_data(names_vec);
+  uint64_t *names_validity = duckdb_vector_get_validity(names_vec);
+
+  oast_extract_opts_t opts;
+  memset(&opts, 0, sizeof(opts));
+  duckdb_list_entry filter_entry = {0, 0};
+  bool have_filter = false;
+
+  oast_span_arena_t arena;
+  oast_span_arena_init(&arena);
+
+  for (idx_t row = 0; row < count; row++) {
+    if (input_validity && !duckdb_validity_row_is_valid(input_validity, row)) {
+      duckdb_vector_ensure_validity_writable(output);
+      duckdb_validity_set_row_invalid(duckdb_vector_get_validity(output), row);
+      continue;
+    }
+
+    opts.max_matches =
+        !max_validity || duckdb_validity_row_is_valid(max_validity, row)
+            ? max_data[row]
+            : 0;
+    opts.dedup =
+        (!dedup_validity || duckdb_validity_row_is_valid(dedup_validity, row)) &&
+        dedup_data[row];
+
+    if (suffix_validity && !duckdb_validity_row_is_valid(suffix_validity, row)) {
+      opts.filter_suffixes = false;
+    } else {
+      if (!have_filter || suffix_entries[row].offset != filter_entry.offset ||
+          suffix_entries[row].length != filter_entry.length) {
+        filter_entry = suffix_entries[row];
+        have_filter = true;
+        memset(opts.suffix_mask, 0, sizeof(opts.suffix_mask));
+        for (idx_t i = 0; i < filter_entry.length; i++) {
+          idx_t k = filter_entry.offset + i;
+          if (names_validity &&
+              !duckdb_validity_row_is_valid(names_validity, k)) {
+            continue;
+          }
+          const char *name = duckdb_string_t_data(&names[k]);
+          size_t name_len = duckdb_string_t_length(names[k]);
+          if (!oast_extract_opts_allow_suffix(&opts, name, name_len)) {
+            char error[128];
+            snprintf(error, sizeof(error), "unknown OAST suffix '%.*s'",
+                     (int)(name_len < 64 ? name_len : 64), name);
+            oast_span_arena_free(&arena);
+            duckdb_scalar_function_set_error(info, error);
+            return;
+          }
+        }
+      }
+      // An empty list allows no suffix at all
+      opts.filter_suffixes = true;
+    }
+
+    duckdb_string_t str = input_data[row];
+    const char *str_data = duckdb_string_t_data(&str);
+    size_t str_len = duckdb_string_t_length(str);
+
+    oast_span_arena_reset(&arena);
+    size_t match_count = 0;
+    if (oast_extract_spans_opts(str_data, str_len, OAST_SHAPE_DEFAULT, &opts,
+                                &arena, &match_count) != 0 ||
+        !AssignMatchesJSON(output, row, str_data, arena.spans, match_count)) {
+      duckdb_vector_ensure_validity_writable(output);
+      duckdb_validity_set_row_invalid(duckdb_vector_get_validity(output), row);
+    }
+  }
+
+  oast_span_arena_free(&arena);
+}
+
+// True if every one of the first count rows of vector is NULL. Input
+// vectors arrive flattened, so a constant NULL shows up as an all-invalid
+// validity mask.
+static bool AllRowsNull(duckdb_vector vector, idx_t count) {
+  uint64_t *validity = duckdb_vector_get_validity(vector);
+  if (!validity) {
+    return count == 0;
+  }
+  for (idx_t i = 0; i < count / 64; i++) {
+    if (validity[i] != 0) {
+      return false;
+    }
+  }
+  return count % 64 == 0 ||
+         (validity[count / 64] & (((uint64_t)1 << (count % 64)) - 1)) == 0;
+}
+
+// oast_extract(VARCHAR) -> VARCHAR (JSON array of strings)
+static void OASTExtractFunction(duckdb_function_info info,
+                                duckdb_data_chunk input, duckdb_vector output) {
+  idx_t count = duckdb_data_chunk_get_size(input);
+
+  // A plain oast_extract(text) reaches here through OAST_EXTRACT_MACRO with
+  // every option NULL; only chunks with some option set take the options
+  // path
+  if (duckdb_data_chunk_get_column_count(input) == 4 &&
+      !(AllRowsNull(duckdb_data_chunk_get_vector(input, 1), count) &&
+        AllRowsNull(duckdb_data_chunk_get_vector(input, 2), count) &&
+        AllRowsNull(duckdb_data_chunk_get_vector(input, 3), count))) {
+    ExtractOptionsRows(info, input, output);
+    return;
+  }
+
+  duckdb_vector input_vec = duckdb_data_chunk_get_vector(input, 0);
+  duckdb_string_t *input_data =
+      (duckdb_string_t *)duckdb_vector_get_data(input_vec);
+  uint64_t *input_validity = duckdb_vector_get_validity(input_vec);
+
+  // Reused by every row, so rows with few matches never allocate
+  oast_span_arena_t arena;
+  oast_span_arena_init(&arena);
+
+  if (input_validity) {
+    duckdb_vector_ensure_validity_writable(output);
+    uint64_t *output_validity = duckdb_vector_get_validity(output);
+
+    for (idx_t row = 0; row < count; row++) {
+      if (duckdb_validity_row_is_valid(input_validity, row)) {
+        duckdb_string_t str = input_data[row];
+        const char *str_data = duckdb_string_t_data(&str);
+        size_t str_len = duckdb_string_t_length(str);
+
+        oast_span_arena_reset(&arena);
+        size_t match_count = 0;
+        if (oast_extract_spans(str_data, str_len, OAST_SHAPE_DEFAULT, &arena,
+                               &match_count) != 0 ||
+            !AssignMatchesJSON(output, row, str_data, arena.spans,
+                               match_count)) {
+          duckdb_validity_set_row_invalid(output_validity, row);
+        }
+      } else {
+        duckdb_validity_set_row_invalid(output_validity, row);
+      }
+    }
+  } else {
+    for (idx_t row = 0; row < count; row++) {
+      duckdb_string_t str = input_data[row];
+      const char *str_data = duckdb_string_t_data(&str);
+      size_t str_len = duckdb_string_t_length(str);
+
+      oast_span_arena_reset(&arena);
+      size_t match_count = 0;
+      if (oast_extract_spans(str_data, str_len, OAST_SHAPE_DEFAULT, &arena,
+                             &match_count) != 0 ||
+          !AssignMatchesJSON(output, row, str_data, arena.spans,
+                             match_count)) {
+        duckdb_vector_ensure_validity_writable(output);
+        duckdb_validity_set_row_invalid(duckdb_vector_get_validity(output),
+                                        row);
+      }
+    }
+  }
+
+  oast_span_arena_free(&arena);
+}
+
+// Pass 1 of the list extractors (oast_extract_list, oast_extract_structs,
+// oast_extract_spans): extract every row of input into arena and lay out
+// the list entries of output. The spans of every row end up back to back in
+// row order: row's matches are arena->spans[entries[row].offset - base ...].
+// On failure the arena is freed, the error is set and false is returned.
+static bool ExtractListEntries(duckdb_function_info info,
+                               duckdb_data_chunk input, duckdb_vector output,
+                               oast_span_arena_t *arena,
+                               const char *oom_error, idx_t *base_out,
+                               idx_t *total_out) {
+  idx_t count = duckdb_data_chunk_get_size(input);
+
+  duckdb_vector input_vec = duckdb_data_chunk_get_vector(input, 0);
+  duckdb_string_t *input_data =
+      (duckdb_string_t *)duckdb_vector_get_data(input_vec);
+  uint64_t *input_validity = duckdb_vector_get_validity(input_vec);
+
+  oast_shape_args_t args;
+  InitShapeArgs(&args, input, 1);
+
+  duckdb_list_entry *entries =
+      (duckdb_list_entry *)duckdb_vector_get_data(output);
+
+  idx_t base = duckdb_list_vector_get_size(output);
+  idx_t total = base;
+  for (idx_t row = 0; row < count; row++) {
+    oast_shape_t shape;
+    if ((input_validity &&
+         !duckdb_validity_row_is_valid(input_validity, row)) ||
+        !GetRowShape(&args, row, &shape)) {
+      duckdb_vector_ensure_validity_writable(output);
+      duckdb_validity_set_row_invalid(duckdb_vector_get_validity(output), row);
+      entries[row].offset = total;
+      entries[row].length = 0;
+      continue;
+    }
+
+    duckdb_string_t str = input_data[row];
+    const char *str_data = duckdb_string_t_data(&str);
+    size_t str_len = duckdb_string_t_length(str);
+
+    const char *error = !oast_shape_is_valid(shape) ? SHAPE_ERROR : NULL;
+    size_t match_count = 0;
+    if (!error && oast_extract_spans(str_data, str_len, shape, arena,
+                                     &match_count) != 0) {
+      error = oom_error;
+    }
+    if (error) {
+      oast_span_arena_free(arena);
+      duckdb_scalar_function_set_error(info, error);
+      return false;
+    }
+
+    entries[row].offset = total;
+    entries[row].length = match_count;
+    total += match_count;
+  }
+
+  *base_out = base;
+  *total_out = total;
+  return true;
+}
+
+// oast_extract_list(VARCHAR [, cid_len, nonce_len]) -> LIST(VARCHAR)
+// Same two-pass layout as oast_extract_structs; child strings are written
+// straight from the match spans in the input.
+static void OASTExtractListFunction(duckdb_function_info info,
+                                    duckdb_data_chunk input,
+                                    duckdb_vector output) {
+  idx_t count = duckdb_data_chunk_get_size(input);
+
+  duckdb_vector input_vec = duckdb_data_chunk_get_vector(input, 0);
+  duckdb_string_t *input_data =
+      (duckdb_string_t *)duckdb_vector_get_data(input_vec);
+
+  duckdb_list_entry *entries =
+      (duckdb_list_entry *)duckdb_vector_get_data(output);
+
+  oast_span_arena_t arena;
+  oast_span_arena_init(&arena);
+
+  // Pass 1: find matches and lay out list entries
+  idx_t base, total;
+  if (!ExtractListEntries(info, input, output, &arena,
+                          "oast_extract_list: out of memory", &base, &total)) {
+    return;
+  }
+
+  // Pass 2: size the child once, then copy each span into it
+  duckdb_list_vector_reserve(output, total);
+  duckdb_list_vector_set_size(output, total);
+
+  duckdb_vector child = duckdb_list_vector_get_child(output);
+
+  for (idx_t row = 0; row < count; row++) {
+    const char *text = duckdb_string_t_data(&input_data[row]);
+    const oast_span_t *spans = arena.spans + (entries[row].offset - base);
+    for (idx_t i = 0; i < entries[row].length; i++) {
+      duckdb_vector_assign_string_element_len(
+          child, entries[row].offset + i, text + spans[i].start, spans[i].len);
+    }
+  }
+
+  oast_span_arena_free(&arena);
+}
+
+// Code points in s[0, n): every byte that is not a UTF-8 continuation byte
+static size_t CountCodePoints(const char *s, size_t n) {
+  size_t continuation = 0;
+  for (size_t i = 0; i < n; i++) {
+    continuation += ((uint8_t)s[i] & 0xC0) == 0x80;
+  }
+  return n - continuation;
+}
+
+// oast_extract_spans(VARCHAR [, cid_len, nonce_len]) ->
+// LIST(STRUCT(start UINTEGER, len USMALLINT, suffix_id UTINYINT))
+// Same two-pass layout as oast_extract_list, but pass 2 writes the spans
+// instead of copying the domains. start is the 1-based character position,
+// so substr(text, start, len) is the domain (domains are ASCII, so len is
+// both bytes and characters).
+static void OASTExtractSpansFunction(duckdb_function_info info,
+                                     duckdb_data_chunk input,
+                                     duckdb_vector output) {
+  idx_t count = duckdb_data_chunk_get_size(input);
+
+  duckdb_vector input_vec = duckdb_data_chunk_get_vector(input, 0);
+  duckdb_string_t *input_data =
+      (duckdb_string_t *)duckdb_vector_get_data(input_vec);
+
+  duckdb_list_entry *entries =
+      (duckdb_list_entry *)duckdb_vector_get_data(output);
+
+  oast_span_arena_t arena;
+  oast_span_arena_init(&arena);
+
+  // Pass 1: find matches and lay out list entries
+  idx_t base, total;
+  if (!ExtractListEntries(info, input, output, &arena,
+                          "oast_extract_spans: out of memory", &base,
+                          &total)) {
+    return;
+  }
+
+  // Pass 2: size the child once, then write each span's fields
+  duckdb_list_vector_reserve(output, total);
+  duckdb_list_vector_set_size(output, total);
+
+  duckdb_vector child = duckdb_list_vector_get_child(output);
+  uint32_t *starts = (uint32_t *)duckdb_vector_get_data(
+      duckdb_struct_vector_get_child(child, 0));
+  uint16_t *lens = (uint16_t *)duckdb_vector_get_data(
+      duckdb_struct_vector_get_child(child, 1));
+  uint8_t *suffix_ids = (uint8_t *)duckdb_vector_get_data(
+      duckdb_struct_vector_get_child(child, 2));
+
+  for (idx_t row = 0; row < count; row++) {
+    const char *text = duckdb_string_t_data(&input_data[row]);
+    const oast_span_t *spans = arena.spans + (entries[row].offset - base);
+    size_t pos = 0;   // Byte offset scanned up to
+    size_t chars = 0; // Characters before pos
+    for (idx_t i = 0; i < entries[row].length; i++) {
+      idx_t k = entries[row].offset + i;
+      chars += CountCodePoints(text + pos, spans[i].start - pos);
+      starts[k] = (uint32_t)(chars + 1);
+      lens[k] = (uint16_t)spans[i].len;
+      suffix_ids[k] = (uint8_t)spans[i].suffix_id;
+      pos = spans[i].start + spans[i].len;
+      chars += spans[i].len;
+    }
+  }
+
+  oast_span_arena_free(&arena);
+}
+
+// Bytes of one oast_extract_decode JSON object besides its two copies of
+// the domain (original and nonce): keys, punctuation, numbers, ksort,
+// campaign and the separating comma
+#define OAST_DECODED_JSON_OVERHEAD 160
+
+static char *AppendLiteral(char *out, const char *s) {
+  size_t n = strlen(s);
+  memcpy(out, s, n);
+  return out + n;
+}
+
+static char *AppendLower(char *out, const char *src, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    out[i] = (char)tolower((unsigned char)src[i]);
+  }
+  return out + n;
+}
+
+static char *AppendDecimal(char *out, uint32_t v) {
+  char digits[10];
+  size_t n = 0;
+  do {
+    digits[n++] = (char)('0' + v % 10);
+    v /= 10;
+  } while (v);
+  while (n) {
+    *out++ = digits[--n];
+  }
+  return out;
+}
+
+// Append the JSON object for one extracted default-shape domain whose XID
+// was decoded during extraction. Extracted domains always decode, so valid
+// is always true. Returns the new end of out.
+static char *AppendDecodedJSON(char *out, const char *domain, size_t len,
+                               size_t subdomain_len, const oast_xid_t *xid) {
+  out = AppendLiteral(out, "{\"original\":\"");
+  memcpy(out, domain, len);
+  out += len;
+  out = AppendLiteral(out, "\",\"valid\":true,\"ts\":");
+  out = AppendDecimal(out, oast_xid_timestamp(xid));
+
+  out = AppendLiteral(out, ",\"machine_id\":\"");
+  uint32_t machine_id = oast_xid_machine_id(xid);
+  for (int b = 0; b < 3; b++) {
+    uint8_t byte = (uint8_t)(machine_id >> (16 - 8 * b));
+    *out++ = HEX_DIGITS[byte >> 4];
+    *out++ = HEX_DIGITS[byte & 0x0F];
+    if (b < 2) {
+      *out++ = ':';
+    }
+  }
+
+  out = AppendLiteral(out, "\",\"pid\":");
+  out = AppendDecimal(out, oast_xid_pid(xid));
+  out = AppendLiteral(out, ",\"counter\":");
+  out = AppendDecimal(out, oast_xid_counter(xid));
+  out = AppendLiteral(out, ",\"ksort\":\"");
+  out = AppendLower(out, domain, 6);
+  out = AppendLiteral(out, "\",\"campaign\":\"");
+  out = AppendLower(out, domain + 6, 5);
+  out = AppendLiteral(out, "\",\"nonce\":\"");
+  out = AppendLower(out, domain + OAST_CID_LEN, subdomain_len - OAST_CID_LEN);
+  return AppendLiteral(out, "\"}");
+}
+
+// oast_extract_decode(VARCHAR) -> VARCHAR (JSON array of decoded objects)
+// Uses the fused extract + decode kernel: each correlation id is decoded
+// once, during extraction, and the objects are formatted from the XIDs.
+static void OASTExtractDecodeFunction(duckdb_function_info info,
+                                      duckdb_data_chunk input,
+                                      duckdb_vector output) {
+  idx_t count = duckdb_data_chunk_get_size(input);
+
+  duckdb_vector input_vec = duckdb_data_chunk_get_vector(input, 0);
+  duckdb_string_t *input_data =
+      (duckdb_string_t *)duckdb_vector_get_data(input_vec);
+  uint64_t *input_validity = duckdb_vector_get_validity(input_vec);
+
+  oast_span_arena_t arena;
+  oast_span_arena_init_decoding(&arena);
+
+  char stack_json[16384];
+  for (idx_t row = 0; row < count; row++) {
+    if (input_validity && !duckdb_validity_row_is_valid(input_validity, row)) {
+      duckdb_vector_ensure_validity_writable(output);
+      duckdb_validity_set_row_invalid(duckdb_vector_get_validity(output), row);
+      continue;
+    }
+
+    duckdb_string_t str = input_data[row];
+    const char *str_data = duckdb_string_t_data(&str);
+    size_t str_len = duckdb_string_t_length(str);
+
+    oast_span_arena_reset(&arena);
+    size_t match_count = 0;
+    if (oast_extract_spans(str_data, str_len, OAST_SHAPE_DEFAULT, &arena,
+                           &match_count) != 0) {
+      oast_span_arena_free(&arena);
+      duckdb_scalar_function_set_error(info,
+                                       "oast_extract_decode: out of memory");
+      return;
+    }
+
+    // Sized exactly, so no object is ever truncated
+    size_t needed = 2; // [ ]
+    for (size_t i = 0; i < match_count; i++) {
+      needed += 2 * (size_t)arena.spans[i].len + OAST_DECODED_JSON_OVERHEAD;
+    }
+    char *json = needed <= sizeof(stack_json) ? stack_json : malloc(needed);
+    if (!json) {
+      oast_span_arena_free(&arena);
+      duckdb_scalar_function_set_error(info,
+                                       "oast_extract_decode: out of memory");
+      return;
+    }
+
+    char *end = json;
+    *end++ = '[';
+    for (size_t i = 0; i < match_count; i++) {
+      const oast_span_t *span = &arena.spans[i];
+      if (i > 0) {
+        *end++ = ',';
+      }
+      end = AppendDecodedJSON(end, str_data + span->start, span->len,
+                              oast_span_subdomain_len(span), &arena.xids[i]);
+    }
+    *end++ = ']';
+
+    duckdb_vector_assign_string_element_len(output, row, json,
+                                            (idx_t)(end - json));
+    if (json != stack_json) {
+      free(json);
+    }
+  }
+
+  oast_span_arena_free(&arena);
+}
+
+// oast_extract_structs(VARCHAR [, cid_len, nonce_len]) -> LIST(STRUCT)
+// Two passes per chunk: extract every row first so the list child can be
+// reserved once for the whole chunk, then write the child STRUCT. The
+// correlation ids are decoded during extraction (fused kernel), so pass 2
+// only slices strings and unpacks XIDs.
+static void OASTExtractStructsFunction(duckdb_function_info info,
+                                       duckdb_data_chunk input,
+                                       duckdb_vector output) {
+  idx_t count = duckdb_data_chunk_get_size(input);
+
+  duckdb_vector input_vec = duckdb_data_chunk_get_vector(input, 0);
+  duckdb_string_t *input_data =
+      (duckdb_string_t *)duckdb_vector_get_data(input_vec);
+
+  oast_shape_args_t args;
+  InitShapeArgs(&args, input, 1);
+
+  duckdb_list_entry *entries =
+      (duckdb_list_entry *)duckdb_vector_get_data(output);
+
+  // Spans and XIDs of every row, back to back in row order: row's matches
+  // are arena.spans[entries[row].offset - base ...]
+  oast_span_arena_t arena;
+  oast_span_arena_init_decoding(&arena);
+
+  // Pass 1: find matches and lay out list entries
+  idx_t base, total;
+  if (!ExtractListEntries(info, input, output, &arena,
+                          "oast_extract_structs: out of memory", &base,
+                          &total)) {
+    return;
+  }
+
+  // Pass 2: size the child once, then decode every match into it
+  duckdb_list_vector_reserve(output, total);
+  duckdb_list_vector_set_size(output, total);
+
+  duckdb_vector child = duckdb_list_vector_get_child(output);
+  oast_struct_writer_t writer;
+  InitStructWriter(&writer, child, &OAST_DECODE_LAYOUT);
+
+  // Matches of consecutive rows are contiguous in the child, so they are
+  // written in blocks that may span rows (of the same shape)
+  const char *ptrs[OAST_DECODE_BATCH_BLOCK];
+  size_t lens[OAST_DECODE_BATCH_BLOCK];
+  uint64_t hi[OAST_DECODE_BATCH_BLOCK];
+  uint32_t lo[OAST_DECODE_BATCH_BLOCK];
+  uint16_t nonce_lens[OAST_DECODE_BATCH_BLOCK];
+  const oast_predecoded_t pre = {hi, lo, nonce_lens};
+  idx_t pending = 0;
+  idx_t block_start = 0;
+  oast_shape_t block_shape = OAST_SHAPE_DEFAULT;
+  for (idx_t row = 0; row < count; row++) {
+    const char *text = duckdb_string_t_data(&input_data[row]);
+    const oast_span_t *spans = arena.spans + (entries[row].offset - base);
+    const oast_xid_t *xids = arena.xids + (entries[row].offset - base);
+    oast_shape_t shape = OAST_SHAPE_DEFAULT;
+    if (entries[row].length > 0) {
+      GetRowShape(&args, row, &shape);
+      if (pending > 0 && !ShapeEquals(shape, block_shape)) {
+        WriteDecodedBatch(&writer, block_start, ptrs, lens, &pre, pending,
+                          block_shape);
+        pending = 0;
+      }
+      block_shape = shape;
+    }
+    for (idx_t i = 0; i < entries[row].length; i++) {
+      if (pending == 0) {
+        block_start = entries[row].offset + i;
+      }
+      ptrs[pending] = text + spans[i].start;
+      lens[pending] = spans[i].len;
+      hi[pending] = xids[i].hi;
+      lo[pending] = xids[i].lo;
+      nonce_lens[pending] =
+          (uint16_t)(oast_span_subdomain_len(&spans[i]) - block_shape.cid_len);
+      if (++pending == OAST_DECODE_BATCH_BLOCK) {
+        WriteDecodedBatch(&writer, block_start, ptrs, lens, &pre, pending,
+                          block_shape);
+        pending = 0;
+      }
+    }
+  }
+  if (pending > 0) {
+    WriteDecodedBatch(&writer, block_start, ptrs, lens, &pre, pending,
+                      block_shape);
+  }
+
+  oast_span_arena_free(&arena);
+}
+
+// oast_encode(ts, machine_id, pid, counter, nonce, suffix) -> VARCHAR
+// Shared body of the VARCHAR- and UHUGEINT-nonce overloads. NULL in any
+// argument gives NULL; out-of-range fields and bad nonces are errors.
+static void EncodeRows(duckdb_function_info info, duckdb_data_chunk input,
+                       duckdb_vector output, bool nonce_is_int) {
+  idx_t count = duckdb_data_chunk_get_size(input);
+
+  void *data[6];
+  uint64_t *validity[6];
+  for (idx_t col = 0; col < 6; col++) {
+    duckdb_vector vec = duckdb_data_chunk_get_vector(input, col);
+    data[col] = duckdb_vector_get_data(vec);
+    validity[col] = duckdb_vector_get_validity(vec);
+  }
+  duckdb_timestamp *ts_data = (duckdb_timestamp *)data[0];
+  uint32_t *machine_data = (uint32_t *)data[1];
+  uint16_t *pid_data = (uint16_t *)data[2];
+  uint32_t *counter_data = (uint32_t *)data[3];
+  duckdb_string_t *suffix_data = (duckdb_string_t *)data[5];
+
+  for (idx_t row = 0; row < count; row++) {
+    bool is_null = false;
+    for (idx_t col = 0; col < 6; col++) {
+      if (validity[col] && !duckdb_validity_row_is_valid(validity[col], row)) {
+        is_null = true;
+      }
+    }
+    if (is_null) {
+      duckdb_vector_ensure_validity_writable(output);
+      duckdb_validity_set_row_invalid(duckdb_vector_get_validity(output), row);
+      continue;
+    }
+
+    int64_t micros = ts_data[row].micros;
+    int64_t secs = micros / 1000000 - (micros % 1000000 < 0 ? 1 : 0);
+    if (secs < 0 || secs > (int64_t)UINT32_MAX) {
+      duckdb_scalar_function_set_error(
+          info, "oast_encode: ts outside the 32-bit XID range (1970-2106)");
+      return;
+    }
+    if (machine_data[row] > 0xFFFFFF || counter_data[row] > 0xFFFFFF) {
+      duckdb_scalar_function_set_error(
+          info, "oast_encode: machine_id and counter must fit in 24 bits");
+      return;
+    }
+
+    // preamble + nonce + '.' + suffix
+    char buf[512];
+    oast_encode_preamble((uint32_t)secs, machine_data[row], pid_data[row],
+                         counter_data[row], buf);
+    size_t len = 20;
+
+    if (nonce_is_int) {
+      duckdb_uhugeint nonce = ((duckdb_uhugeint *)data[4])[row];
+      size_t n = oast_encode_nonce_int(nonce.upper, nonce.lower, buf + len);
+      if (n == 0) {
+        duckdb_scalar_function_set_error(
+            info, "oast_encode: nonce integer has no length sentinel");
+        return;
+      }
+      len += n;
+    } else {
+      duckdb_string_t *nonce = &((duckdb_string_t *)data[4])[row];
+      const char *n_data = duckdb_string_t_data(nonce);
+      size_t n_len = duckdb_string_t_length(*nonce);
+      if (n_len > 128) {
+        duckdb_scalar_function_set_error(info, "oast_encode: nonce too long");
+        return;
+      }
+      if (n_len == 0) {
+        duckdb_scalar_function_set_error(info, "oast_encode: nonce is empty");
+        return;
+      }
+      for (size_t i = 0; i < n_len; i++) {
+        if (!oast_char_has(n_data[i], OAST_CC_ZBASE32)) {
+          duckdb_scalar_function_set_error(
+              info, "oast_encode: nonce contains non z-base-32 characters");
+          return;
+        }
+        buf[len++] = (char)tolower((unsigned char)n_data[i]);
+      }
+    }
+
+    const char *suffix = duckdb_string_t_data(&suffix_data[row]);
+    size_t suffix_len = duckdb_string_t_length(suffix_data[row]);
+    if (suffix_len > 0) {
+      // Only a known suffix, matched in full, gives a domain the validator
+      // and the extractor accept
+      int idx = oast_match_suffix(suffix, suffix_len);
+      if (idx < 0 || oast_suffix_len(idx) != suffix_len) {
+        duckdb_scalar_function_set_error(
+            info, "oast_encode: suffix is not a known OAST suffix");
+        return;
+      }
+      buf[len++] = '.';
+      memcpy(buf + len, suffix, suffix_len);
+      len += suffix_len;
+    }
+
+    duckdb_vector_assign_string_element_len(output, row, buf, len);
+  }
+}
+
+static void OASTEncodeFunction(duckdb_function_info info,
+                               duckdb_data_chunk input, duckdb_vector output) {
+  EncodeRows(info, input, output, false);
+}
+
+static void OASTEncodeNonceIntFunction(duckdb_function_info info,
+                                       duckdb_data_chunk input,
+                                       duckdb_vector output) {
+  EncodeRows(info, input, output, true);
+}
+
+// oast_error_message(UTINYINT) -> VARCHAR
+// Message text for a decode error_code; NULL for 0 (no error) and unknown
+// codes
+static void OASTErrorMessageFunction(duckdb_function_info info,
+                                     duckdb_data_chunk input,
+                                     duckdb_vector output) {
+  idx_t count = duckdb_data_chunk_get_size(input);
+
+  duckdb_vector input_vec = duckdb_data_chunk_get_vector(input, 0);
+  uint8_t *codes = (uint8_t *)duckdb_vector_get_data(input_vec);
+  uint64_t *input_validity = duckdb_vector_get_validity(input_vec);
+
+  for (idx_t row = 0; row < count; row++) {
+    const char *message = NULL;
+    if (!input_validity || duckdb_validity_row_is_valid(input_validity, row)) {
+      message = oast_decode_error_message(codes[row]);
+    }
+    if (!message) {
+      duckdb_vector_ensure_validity_writable(output);
+      duckdb_validity_set_row_invalid(duckdb_vector_get_validity(output), row);
+      continue;
+    }
+    duckdb_vector_assign_string_element_len(output, row, message,
+                                            strlen(message));
+  }
+}
+
+// oast_suffix_name(UTINYINT) -> VARCHAR
+// Known OAST suffix for a suffix_id from oast_extract_spans; NULL for ids
+// out of range
+static void OASTSuffixNameFunction(duckdb_function_info info,
+                                   duckdb_data_chunk input,
+                                   duckdb_vector output) {
+  idx_t count = duckdb_data_chunk_get_size(input);
+
+  duckdb_vector input_vec = duckdb_data_chunk_get_vector(input, 0);
+  uint8_t *ids = (uint8_t *)duckdb_vector_get_data(input_vec);
+  uint64_t *input_validity = duckdb_vector_get_validity(input_vec);
+
+  size_t known = 0;
+  while (KNOWN_OAST_DOMAINS[known]) {
+    known++;
+  }
+
+  for (idx_t row = 0; row < count; row++) {
+    if ((input_validity &&
+         !duckdb_validity_row_is_valid(input_validity, row)) ||
+        ids[row] >= known) {
+      duckdb_vector_ensure_validity_writable(output);
+      duckdb_validity_set_row_invalid(duckdb_vector_get_validity(output), row);
+      continue;
+    }
+    duckdb_vector_assign_string_element_len(output, row,
+                                            KNOWN_OAST_DOMAINS[ids[row]],
+                                            oast_suffix_len(ids[row]));
+  }
+}
+
+// oast_simd_kernel() -> VARCHAR
+// Name of the kernel family picked at load ("avx2", "sse4.1" or "scalar")
+static void OASTSimdKernelFunction(duckdb_function_info info,
+                                   duckdb_data_chunk input,
+                                   duckdb_vector output) {
+  idx_t size = duckdb_data_chunk_get_size(input);
+  const char *name = oast_simd_level_name(oast_simd_get_level());
+  idx_t name_len = (idx_t)strlen(name);
+
+  for (idx_t row = 0; row < size; row++) {
+    duckdb_vector_assign_string_element_len(output, row, name, name_len);
+  }
+}
+
+// Register name as a function set: (VARCHAR) plus a shaped overload taking
+// shape_args more UTINYINT arguments (cid_len [, nonce_len]). Both call
+// function, which tells them apart by column count.
+static void RegisterShapedFunction(duckdb_connection connection,
+                                   const char *name,
+                                   duckdb_logical_type return_type,
+                                   duckdb_scalar_function_t function,
+                                   idx_t shape_args, void *extra_info) {
+  duckdb_logical_type varchar_type =
+      duckdb_create_logical_type(DUCKDB_TYPE_VARCHAR);
+  duckdb_logical_type utinyint_type =
+      duckdb_create_logical_type(DUCKDB_TYPE_UTINYINT);
+  duckdb_scalar_function_set set = duckdb_create_scalar_function_set(name);
+
+  for (int shaped = 0; shaped < 2; shaped++) {
+    idx_t extra = shaped ? shape_args : 0;
+    duckdb_scalar_function overload = duckdb_create_scalar_function();
+    duckdb_scalar_function_set_name(overload, name);
+    duckdb_scalar_function_add_parameter(overload, varchar_type);
+    for (idx_t i = 0; i < extra; i++) {
+      duckdb_scalar_function_add_parameter(overload, utinyint_type);
+    }
+    duckdb_scalar_function_set_return_type(overload, return_type);
+    if (extra_info) {
+      duckdb_scalar_function_set_extra_info(overload, extra_info, NULL);
+    }
+    duckdb_scalar_function_set_function(overload, function);
+    duckdb_add_scalar_function_to_set(set, overload);
+    duckdb_destroy_scalar_function(&overload);
+  }
+  duckdb_register_scalar_function_set(connection, set);
+  duckdb_destroy_scalar_function_set(&set);
+
+  duckdb_destroy_logical_type(&utinyint_type);
+  duckdb_destroy_logical_type(&varchar_type);
+}
+
+void RegisterOASTFunctions(duckdb_connection connection) {
+  duckdb_logical_type varchar_type =
+      duckdb_create_logical_type(DUCKDB_TYPE_VARCHAR);
+  duckdb_logical_type bool_type =
+      duckdb_create_logical_type(DUCKDB_TYPE_BOOLEAN);
+
+  // Register oast_validate(VARCHAR [, VARCHAR] [, UTINYINT, UTINYINT]) ->
+  // BOOLEAN
+  {
+    duckdb_logical_type utinyint_type =
+        duckdb_create_logical_type(DUCKDB_TYPE_UTINYINT);
+    duckdb_scalar_function_set set =
+        duckdb_create_scalar_function_set("oast_validate");
+
+    for (int with_level = 0; with_level < 2; with_level++) {
+      for (int with_shape = 0; with_shape < 2; with_shape++) {
+        duckdb_scalar_function function = duckdb_create_scalar_function();
+        duckdb_scalar_function_set_name(function, "oast_validate");
+        duckdb_scalar_function_add_parameter(function, varchar_type);
+        if (with_level) {
+          duckdb_scalar_function_add_parameter(function, varchar_type);
+        }
+        if (with_shape) {
+          duckdb_scalar_function_add_parameter(function, utinyint_type);
+          duckdb_scalar_function_add_parameter(function, utinyint_type);
+        }
+        duckdb_scalar_function_set_return_type(function, bool_type);
+        duckdb_scalar_function_set_function(function, OASTValidateFunction);
+        duckdb_add_scalar_function_to_set(set, function);
+        duckdb_destroy_scalar_function(&function);
+      }
+    }
+    duckdb_register_scalar_function_set(connection, set);
+    duckdb_destroy_scalar_function_set(&set);
+
+    duckdb_destroy_logical_type(&utinyint_type);
   }
 
   // Register oast_decode_json(VARCHAR) -> VARCHAR
@@ -410,17 +1983,186 @@ void RegisterOASTFunctions(duckdb_connection connection) {
     duckdb_destroy_scalar_function(&function);
   }
 
-  // Register oast_extract(VARCHAR) -> VARCHAR (JSON array)
+  // Register oast_decode(VARCHAR [, UTINYINT]) -> STRUCT and
+  // oast_summary(VARCHAR [, UTINYINT]) -> STRUCT (native, no JSON round trip)
+  {
+    const oast_struct_layout_t *layouts[] = {&OAST_DECODE_LAYOUT,
+                                             &OAST_SUMMARY_LAYOUT};
+    const char *names[] = {"oast_decode", "oast_summary"};
+
+    for (int i = 0; i < 2; i++) {
+      duckdb_logical_type struct_type = CreateStructType(layouts[i]);
+      RegisterShapedFunction(connection, names[i], struct_type,
+                             OASTDecodeStructFunction, 1, (void *)layouts[i]);
+      duckdb_destroy_logical_type(&struct_type);
+    }
+  }
+
+  // Register typed single-field accessors (VARCHAR) -> scalar
   {
+    struct {
+      const char *name;
+      duckdb_type return_type;
+      duckdb_scalar_function_t function;
+    } accessors[] = {
+        {"oast_timestamp", DUCKDB_TYPE_TIMESTAMP_TZ, OASTTimestampFunction},
+        {"oast_machine_id", DUCKDB_TYPE_UINTEGER, OASTMachineIdFunction},
+        {"oast_pid", DUCKDB_TYPE_USMALLINT, OASTPidFunction},
+        {"oast_counter", DUCKDB_TYPE_UINTEGER, OASTCounterFunction},
+        {"oast_ksort", DUCKDB_TYPE_VARCHAR, OASTKsortFunction},
+        {"oast_campaign", DUCKDB_TYPE_VARCHAR, OASTCampaignFunction},
+        {"oast_nonce_int", DUCKDB_TYPE_UHUGEINT, OASTNonceIntFunction},
+    };
+
+    for (size_t i = 0; i < sizeof(accessors) / sizeof(accessors[0]); i++) {
+      duckdb_logical_type return_type =
+          duckdb_create_logical_type(accessors[i].return_type);
+
+      duckdb_scalar_function function = duckdb_create_scalar_function();
+      duckdb_scalar_function_set_name(function, accessors[i].name);
+      duckdb_scalar_function_add_parameter(function, varchar_type);
+      duckdb_scalar_function_set_return_type(function, return_type);
+      duckdb_scalar_function_set_function(function, accessors[i].function);
+      duckdb_register_scalar_function(connection, function);
+      duckdb_destroy_scalar_function(&function);
+
+      duckdb_destroy_logical_type(&return_type);
+    }
+  }
+
+  // Register extraction predicates (VARCHAR [, UTINYINT, UTINYINT]) -> scalar
+  {
+    duckdb_logical_type bigint_type =
+        duckdb_create_logical_type(DUCKDB_TYPE_BIGINT);
+    RegisterShapedFunction(connection, "oast_count", bigint_type,
+                           OASTCountFunction, 2, NULL);
+    RegisterShapedFunction(connection, "oast_has_oast", bool_type,
+                           OASTHasOASTFunction, 2, NULL);
+    duckdb_destroy_logical_type(&bigint_type);
+  }
+
+  // Register oast_ts_fast(VARCHAR [, BOOLEAN]) -> TIMESTAMP
+  {
+    duckdb_logical_type ts_type =
+        duckdb_create_logical_type(DUCKDB_TYPE_TIMESTAMP);
+    duckdb_scalar_function_set set =
+        duckdb_create_scalar_function_set("oast_ts_fast");
+
+    for (int with_strict = 0; with_strict < 2; with_strict++) {
+      duckdb_scalar_function function = duckdb_create_scalar_function();
+      duckdb_scalar_function_set_name(function, "oast_ts_fast");
+      duckdb_scalar_function_add_parameter(function, varchar_type);
+      if (with_strict) {
+        duckdb_scalar_function_add_parameter(function, bool_type);
+      }
+      duckdb_scalar_function_set_return_type(function, ts_type);
+      duckdb_scalar_function_set_function(function, OASTTsFastFunction);
+      duckdb_add_scalar_function_to_set(set, function);
+      duckdb_destroy_scalar_function(&function);
+    }
+    duckdb_register_scalar_function_set(connection, set);
+    duckdb_destroy_scalar_function_set(&set);
+
+    duckdb_destroy_logical_type(&ts_type);
+  }
+
+  // Register oast_ts_prefix_range(TIMESTAMP, TIMESTAMP) -> STRUCT
+  {
+    duckdb_logical_type ts_type =
+        duckdb_create_logical_type(DUCKDB_TYPE_TIMESTAMP);
+    duckdb_logical_type member_types[2] = {varchar_type, varchar_type};
+    const char *member_names[2] = {"lo", "hi"};
+    duckdb_logical_type struct_type =
+        duckdb_create_struct_type(member_types, member_names, 2);
+
     duckdb_scalar_function function = duckdb_create_scalar_function();
-    duckdb_scalar_function_set_name(function, "oast_extract");
-    duckdb_scalar_function_add_parameter(function, varchar_type);
-    duckdb_scalar_function_set_return_type(function, varchar_type);
-    duckdb_scalar_function_set_function(function, OASTExtractFunction);
+    duckdb_scalar_function_set_name(function, "oast_ts_prefix_range");
+    duckdb_scalar_function_add_parameter(function, ts_type);
+    duckdb_scalar_function_add_parameter(function, ts_type);
+    duckdb_scalar_function_set_return_type(function, struct_type);
+    duckdb_scalar_function_set_function(function, OASTTsPrefixRangeFunction);
+    duckdb_register_scalar_function(connection, function);
+    duckdb_destroy_scalar_function(&function);
+
+    duckdb_destroy_logical_type(&struct_type);
+    duckdb_destroy_logical_type(&ts_type);
+  }
+
+  // Register oast_in_prefix_range(VARCHAR, VARCHAR, VARCHAR) -> BOOLEAN
+  {
+    duckdb_scalar_function function = duckdb_create_scalar_function();
+    duckdb_scalar_function_set_name(function, "oast_in_prefix_range");
+    for (int i = 0; i < 3; i++) {
+      duckdb_scalar_function_add_parameter(function, varchar_type);
+    }
+    duckdb_scalar_function_set_return_type(function, bool_type);
+    duckdb_scalar_function_set_function(function, OASTInPrefixRangeFunction);
     duckdb_register_scalar_function(connection, function);
     duckdb_destroy_scalar_function(&function);
   }
 
+  // Register oast_extract(VARCHAR [, UINTEGER, BOOLEAN, VARCHAR[]]) ->
+  // VARCHAR (JSON array). The options overload is reached with named
+  // parameters through OAST_EXTRACT_MACRO.
+  {
+    duckdb_logical_type uinteger_type =
+        duckdb_create_logical_type(DUCKDB_TYPE_UINTEGER);
+    duckdb_logical_type names_type = duckdb_create_list_type(varchar_type);
+    duckdb_scalar_function_set set =
+        duckdb_create_scalar_function_set("oast_extract");
+
+    for (int with_options = 0; with_options < 2; with_options++) {
+      duckdb_scalar_function function = duckdb_create_scalar_function();
+      duckdb_scalar_function_set_name(function, "oast_extract");
+      duckdb_scalar_function_add_parameter(function, varchar_type);
+      if (with_options) {
+        duckdb_scalar_function_add_parameter(function, uinteger_type);
+        duckdb_scalar_function_add_parameter(function, bool_type);
+        duckdb_scalar_function_add_parameter(function, names_type);
+        // NULL options select the defaults, so NULLs must reach the function
+        duckdb_scalar_function_set_special_handling(function);
+      }
+      duckdb_scalar_function_set_return_type(function, varchar_type);
+      duckdb_scalar_function_set_function(function, OASTExtractFunction);
+      duckdb_add_scalar_function_to_set(set, function);
+      duckdb_destroy_scalar_function(&function);
+    }
+    duckdb_register_scalar_function_set(connection, set);
+    duckdb_destroy_scalar_function_set(&set);
+
+    duckdb_destroy_logical_type(&names_type);
+    duckdb_destroy_logical_type(&uinteger_type);
+  }
+
+  // Register oast_extract_list(VARCHAR [, UTINYINT, UTINYINT]) ->
+  // LIST(VARCHAR)
+  {
+    duckdb_logical_type list_type = duckdb_create_list_type(varchar_type);
+    RegisterShapedFunction(connection, "oast_extract_list", list_type,
+                           OASTExtractListFunction, 2, NULL);
+    duckdb_destroy_logical_type(&list_type);
+  }
+
+  // Register oast_extract_spans(VARCHAR [, UTINYINT, UTINYINT]) ->
+  // LIST(STRUCT(start UINTEGER, len USMALLINT, suffix_id UTINYINT))
+  {
+    duckdb_logical_type member_types[3] = {
+        duckdb_create_logical_type(DUCKDB_TYPE_UINTEGER),
+        duckdb_create_logical_type(DUCKDB_TYPE_USMALLINT),
+        duckdb_create_logical_type(DUCKDB_TYPE_UTINYINT)};
+    const char *member_names[3] = {"start", "len", "suffix_id"};
+    duckdb_logical_type struct_type =
+        duckdb_create_struct_type(member_types, member_names, 3);
+    duckdb_logical_type list_type = duckdb_create_list_type(struct_type);
+    RegisterShapedFunction(connection, "oast_extract_spans", list_type,
+                           OASTExtractSpansFunction, 2, NULL);
+    duckdb_destroy_logical_type(&list_type);
+    duckdb_destroy_logical_type(&struct_type);
+    for (int i = 0; i < 3; i++) {
+      duckdb_destroy_logical_type(&member_types[i]);
+    }
+  }
+
   // Register oast_extract_decode(VARCHAR) -> VARCHAR (JSON array)
   {
     duckdb_scalar_function function = duckdb_create_scalar_function();
@@ -432,6 +2174,89 @@ void RegisterOASTFunctions(duckdb_connection connection) {
     duckdb_destroy_scalar_function(&function);
   }
 
+  // Register oast_extract_structs(VARCHAR [, UTINYINT, UTINYINT]) ->
+  // LIST(STRUCT)
+  {
+    duckdb_logical_type struct_type = CreateStructType(&OAST_DECODE_LAYOUT);
+    duckdb_logical_type list_type = duckdb_create_list_type(struct_type);
+    RegisterShapedFunction(connection, "oast_extract_structs", list_type,
+                           OASTExtractStructsFunction, 2, NULL);
+    duckdb_destroy_logical_type(&list_type);
+    duckdb_destroy_logical_type(&struct_type);
+  }
+
+  // Register oast_encode(TIMESTAMPTZ, UINTEGER, USMALLINT, UINTEGER,
+  // VARCHAR | UHUGEINT, VARCHAR) -> VARCHAR
+  {
+    duckdb_type arg_types[] = {DUCKDB_TYPE_TIMESTAMP_TZ, DUCKDB_TYPE_UINTEGER,
+                               DUCKDB_TYPE_USMALLINT, DUCKDB_TYPE_UINTEGER,
+                               DUCKDB_TYPE_VARCHAR, DUCKDB_TYPE_VARCHAR};
+    duckdb_scalar_function_set set =
+        duckdb_create_scalar_function_set("oast_encode");
+
+    for (int nonce_is_int = 0; nonce_is_int < 2; nonce_is_int++) {
+      arg_types[4] = nonce_is_int ? DUCKDB_TYPE_UHUGEINT : DUCKDB_TYPE_VARCHAR;
+
+      duckdb_scalar_function function = duckdb_create_scalar_function();
+      duckdb_scalar_function_set_name(function, "oast_encode");
+      for (int i = 0; i < 6; i++) {
+        duckdb_logical_type type = duckdb_create_logical_type(arg_types[i]);
+        duckdb_scalar_function_add_parameter(function, type);
+        duckdb_destroy_logical_type(&type);
+      }
+      duckdb_scalar_function_set_return_type(function, varchar_type);
+      duckdb_scalar_function_set_function(
+          function,
+          nonce_is_int ? OASTEncodeNonceIntFunction : OASTEncodeFunction);
+      duckdb_add_scalar_function_to_set(set, function);
+      duckdb_destroy_scalar_function(&function);
+    }
+    duckdb_register_scalar_function_set(connection, set);
+    duckdb_destroy_scalar_function_set(&set);
+  }
+
+  // Register oast_error_message(UTINYINT) -> VARCHAR
+  {
+    duckdb_logical_type utinyint_type =
+        duckdb_create_logical_type(DUCKDB_TYPE_UTINYINT);
+
+    duckdb_scalar_function function = duckdb_create_scalar_function();
+    duckdb_scalar_function_set_name(function, "oast_error_message");
+    duckdb_scalar_function_add_parameter(function, utinyint_type);
+    duckdb_scalar_function_set_return_type(function, varchar_type);
+    duckdb_scalar_function_set_function(function, OASTErrorMessageFunction);
+    duckdb_register_scalar_function(connection, function);
+    duckdb_destroy_scalar_function(&function);
+
+    duckdb_destroy_logical_type(&utinyint_type);
+  }
+
+  // Register oast_suffix_name(UTINYINT) -> VARCHAR
+  {
+    duckdb_logical_type utinyint_type =
+        duckdb_create_logical_type(DUCKDB_TYPE_UTINYINT);
+
+    duckdb_scalar_function function = duckdb_create_scalar_function();
+    duckdb_scalar_function_set_name(function, "oast_suffix_name");
+    duckdb_scalar_function_add_parameter(function, utinyint_type);
+    duckdb_scalar_function_set_return_type(function, varchar_type);
+    duckdb_scalar_function_set_function(function, OASTSuffixNameFunction);
+    duckdb_register_scalar_function(connection, function);
+    duckdb_destroy_scalar_function(&function);
+
+    duckdb_destroy_logical_type(&utinyint_type);
+  }
+
+  // Register oast_simd_kernel() -> VARCHAR
+  {
+    duckdb_scalar_function function = duckdb_create_scalar_function();
+    duckdb_scalar_function_set_name(function, "oast_simd_kernel");
+    duckdb_scalar_function_set_return_type(function, varchar_type);
+    duckdb_scalar_function_set_function(function, OASTSimdKernelFunction);
+    duckdb_register_scalar_function(connection, function);
+    duckdb_destroy_scalar_function(&function);
+  }
+
   duckdb_destroy_logical_type(&varchar_type);
   duckdb_destroy_logical_type(&bool_type);
 }
@@ -0,0 +1,260 @@
+#include "oast_simd.h"
+#include "oast_base32.h"
+#include "oast_extract.h"
+#include "oast_validate.h"
+
+#if defined(OAST_HAVE_SSE41)
+#include <immintrin.h>
+#endif
+
+oast_valid_subdomain_fn oast_simd_valid_subdomain =
+    oast_is_valid_subdomain_scalar;
+oast_decode_preamble_fn oast_simd_decode_preamble =
+    base32hex_decode_preamble_scalar;
+
+static oast_kernel_level_t simd_level = OAST_KERNEL_SCALAR;
+
+#if defined(OAST_HAVE_SSE41)
+
+// Set membership by nibble lookup: byte c is in the set iff
+// LO[c & 0xF] & HI[c >> 4] != 0, where HI[h] = 1 << h for the ASCII rows
+// (h < 8) and 0 otherwise, and LO[l] holds one bit per row whose byte is in
+// the set. Built once from OAST_CHAR_CLASS so the tables cannot drift from
+// the scalar path.
+typedef struct {
+  uint8_t hi[32];
+  uint8_t base32hex_lo[32];
+  uint8_t zbase32_lo[32];
+  bool built;
+} nibble_tables_t;
+
+static nibble_tables_t nibbles;
+
+static void build_nibble_tables(void) {
+  if (nibbles.built) {
+    return;
+  }
+  for (int l = 0; l < 16; l++) {
+    uint8_t b32 = 0;
+    uint8_t z32 = 0;
+    for (int h = 0; h < 8; h++) {
+      uint8_t cls = OAST_CHAR_CLASS[(h << 4) | l];
+      if (cls & OAST_CC_BASE32HEX) {
+        b32 |= (uint8_t)(1 << h);
+      }
+      if (cls & OAST_CC_ZBASE32) {
+        z32 |= (uint8_t)(1 << h);
+      }
+    }
+    // Duplicated per 128-bit lane for the AVX2 shuffles
+    nibbles.base32hex_lo[l] = nibbles.base32hex_lo[l + 16] = b32;
+    nibbles.zbase32_lo[l] = nibbles.zbase32_lo[l + 16] = z32;
+    nibbles.hi[l] = nibbles.hi[l + 16] = l < 8 ? (uint8_t)(1 << l) : 0;
+  }
+  nibbles.built = true;
+}
+
+// SSE4.1: validate 16-byte blocks; the last block overlaps the previous one
+// so no load reads past s + len. Lanes before offset 20 are checked against
+// base32hex, the rest against z-base-32.
+OAST_TARGET_SSE41 static bool valid_subdomain_sse41(const char *s,
+                                                    size_t len) {
+  if (len < 33) { // 20 + 13 minimum
+    return false;
+  }
+
+  const __m128i hi_tbl = _mm_loadu_si128((const __m128i *)nibbles.hi);
+  const __m128i b32_tbl = _mm_loadu_si128((const __m128i *)nibbles.base32hex_lo);
+  const __m128i z32_tbl = _mm_loadu_si128((const __m128i *)nibbles.zbase32_lo);
+  const __m128i low4 = _mm_set1_epi8(0x0F);
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i lane = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12,
+                                     13, 14, 15);
+
+  size_t off = 0;
+  for (;;) {
+    if (off + 16 > len) {
+      off = len - 16;
+    }
+    __m128i c = _mm_loadu_si128((const __m128i *)(s + off));
+    __m128i lo_idx = _mm_and_si128(c, low4);
+    __m128i row = _mm_shuffle_epi8(
+        hi_tbl, _mm_and_si128(_mm_srli_epi16(c, 4), low4));
+    __m128i bad_b32 = _mm_cmpeq_epi8(
+        _mm_and_si128(_mm_shuffle_epi8(b32_tbl, lo_idx), row), zero);
+    __m128i bad_z32 = _mm_cmpeq_epi8(
+        _mm_and_si128(_mm_shuffle_epi8(z32_tbl, lo_idx), row), zero);
+
+    __m128i bad = bad_z32;
+    if (off < 20) {
+      __m128i in_preamble =
+          _mm_cmpgt_epi8(_mm_set1_epi8((char)(20 - off)), lane);
+      bad = _mm_blendv_epi8(bad_z32, bad_b32, in_preamble);
+    }
+    if (_mm_movemask_epi8(bad) != 0) {
+      return false;
+    }
+
+    off += 16;
+    if (off >= len) {
+      return true;
+    }
+  }
+}
+
+// AVX2: same as the SSE4.1 kernel over 32-byte blocks (len >= 33 > 32)
+OAST_TARGET_AVX2 static bool valid_subdomain_avx2(const char *s, size_t len) {
+  if (len < 33) {
+    return false;
+  }
+
+  const __m256i hi_tbl = _mm256_loadu_si256((const __m256i *)nibbles.hi);
+  const __m256i b32_tbl =
+      _mm256_loadu_si256((const __m256i *)nibbles.base32hex_lo);
+  const __m256i z32_tbl =
+      _mm256_loadu_si256((const __m256i *)nibbles.zbase32_lo);
+  const __m256i low4 = _mm256_set1_epi8(0x0F);
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i lane = _mm256_setr_epi8(
+      0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20,
+      21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31);
+
+  size_t off = 0;
+  for (;;) {
+    if (off + 32 > len) {
+      off = len - 32;
+    }
+    __m256i c = _mm256_loadu_si256((const __m256i *)(s + off));
+    __m256i lo_idx = _mm256_and_si256(c, low4);
+    __m256i row = _mm256_shuffle_epi8(
+        hi_tbl, _mm256_and_si256(_mm256_srli_epi16(c, 4), low4));
+    __m256i bad_b32 = _mm256_cmpeq_epi8(
+        _mm256_and_si256(_mm256_shuffle_epi8(b32_tbl, lo_idx), row), zero);
+    __m256i bad_z32 = _mm256_cmpeq_epi8(
+        _mm256_and_si256(_mm256_shuffle_epi8(z32_tbl, lo_idx), row), zero);
+
+    __m256i bad = bad_z32;
+    if (off < 20) {
+      __m256i in_preamble =
+          _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(20 - off)), lane);
+      bad = _mm256_blendv_epi8(bad_z32, bad_b32, in_preamble);
+    }
+    if (_mm256_movemask_epi8(bad) != 0) {
+      return false;
+    }
+
+    off += 32;
+    if (off >= len) {
+      return true;
+    }
+  }
+}
+
+// Map 16 chars to base32hex values; *ok gets 0xFF in lanes holding a valid
+// char. Digits are range-checked unfolded so that control bytes never alias
+// into '0'-'9' via the case fold.
+OAST_TARGET_SSE41 static inline __m128i base32hex_values_sse41(__m128i c,
+                                                              __m128i *ok) {
+  __m128i digit = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+  __m128i letter =
+      _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+  __m128i is_digit =
+      _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+  __m128i is_letter =
+      _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(21)), letter);
+  *ok = _mm_or_si128(is_digit, is_letter);
+  return _mm_blendv_epi8(_mm_add_epi8(letter, _mm_set1_epi8(10)), digit,
+                         is_digit);
+}
+
+// SSE4.1 preamble decode: two overlapping 16-byte loads cover the 20 chars.
+// Values are packed 5+5 -> 10 bits (maddubs) and 10+10 -> 20 bits (madd), so
+// each 32-bit lane holds 4 chars; lanes 0-3 of the first load are chars 0-15
+// and lane 3 of the second load is chars 16-19.
+OAST_TARGET_SSE41 static bool decode_preamble_sse41(const char *input,
+                                                    uint64_t *hi_out,
+                                                    uint32_t *lo_out) {
+  __m128i ok_a, ok_b;
+  __m128i va = base32hex_values_sse41(
+      _mm_loadu_si128((const __m128i *)input), &ok_a);
+  __m128i vb = base32hex_values_sse41(
+      _mm_loadu_si128((const __m128i *)(input + 4)), &ok_b);
+
+  const __m128i pair_w = _mm_set1_epi16(0x0120); // bytes (32, 1)
+  const __m128i quad_w = _mm_set1_epi32(0x00010400); // words (1024, 1)
+  __m128i ga = _mm_madd_epi16(_mm_maddubs_epi16(va, pair_w), quad_w);
+  __m128i gb = _mm_madd_epi16(_mm_maddubs_epi16(vb, pair_w), quad_w);
+
+  uint64_t g0 = (uint32_t)_mm_extract_epi32(ga, 0);
+  uint64_t g1 = (uint32_t)_mm_extract_epi32(ga, 1);
+  uint64_t g2 = (uint32_t)_mm_extract_epi32(ga, 2);
+  uint64_t g3 = (uint32_t)_mm_extract_epi32(ga, 3);
+  uint64_t g4 = (uint32_t)_mm_extract_epi32(gb, 3);
+
+  // Same split as the scalar decoder: a = chars 0-11, b = chars 12-19
+  uint64_t a = (g0 << 40) | (g1 << 20) | g2;
+  uint64_t b = (g3 << 20) | g4;
+  *hi_out = (a << 4) | (b >> 36);
+  *lo_out = (uint32_t)(b >> 4);
+
+  return (_mm_movemask_epi8(_mm_and_si128(ok_a, ok_b)) & 0xFFFF) == 0xFFFF;
+}
+
+// The preamble is only 20 bytes, so the AVX2 family reuses the SSE4.1
+// decoder compiled with VEX encoding
+OAST_TARGET_AVX2 static bool decode_preamble_avx2(const char *input,
+                                                  uint64_t *hi_out,
+                                                  uint32_t *lo_out) {
+  return decode_preamble_sse41(input, hi_out, lo_out);
+}
+
+#endif // OAST_HAVE_SSE41
+
+bool oast_simd_set_level(oast_kernel_level_t level) {
+  switch (level) {
+  case OAST_KERNEL_SCALAR:
+    oast_simd_valid_subdomain = oast_is_valid_subdomain_scalar;
+    oast_simd_decode_preamble = base32hex_decode_preamble_scalar;
+    oast_extract_set_kernel(OAST_SCAN_SCALAR);
+    break;
+#if defined(OAST_HAVE_SSE41)
+  case OAST_KERNEL_SSE41:
+    if (!oast_cpu_has_sse41()) {
+      return false;
+    }
+    build_nibble_tables();
+    oast_simd_valid_subdomain = valid_subdomain_sse41;
+    oast_simd_decode_preamble = decode_preamble_sse41;
+    oast_extract_set_kernel(OAST_SCAN_SSE2);
+    break;
+  case OAST_KERNEL_AVX2:
+    if (!oast_cpu_has_avx2() || !oast_cpu_has_sse41()) {
+      return false;
+    }
+    build_nibble_tables();
+    oast_simd_valid_subdomain = valid_subdomain_avx2;
+    oast_simd_decode_preamble = decode_preamble_avx2;
+    oast_extract_set_kernel(OAST_SCAN_AVX2);
+    break;
+#endif
+  default:
+    return false;
+  }
+  simd_level = level;
+  return true;
+}
+
+void oast_simd_init(void) { oast_simd_set_level(oast_cpu_best_level()); }
+
+oast_kernel_level_t oast_simd_get_level(void) { return simd_level; }
+
+const char *oast_simd_level_name(oast_kernel_level_t level) {
+  switch (level) {
+  case OAST_KERNEL_SSE41:
+    return "sse4.1";
+  case OAST_KERNEL_AVX2:
+    return "avx2";
+  default:
+    return "scalar";
+  }
+}
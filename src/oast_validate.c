@@ -1,62 +1,201 @@
 #include "oast_validate.h"
 #include "oast_base32.h"
+#include "oast_cpu.h"
+#include "oast_decode.h"
 #include "oast_domains.h"
+#include "oast_simd.h"
 #include <ctype.h>
+#include <string.h>
 
 bool oast_is_valid_preamble(const char *s, size_t len) {
   if (len != 20) {
     return false;
   }
 
+  // AND the class flags of every char; no early exit per character
+  uint8_t classes = 0xFF;
   for (size_t i = 0; i < len; i++) {
-    if (!is_base32hex_char(s[i])) {
-      return false;
-    }
+    classes &= oast_char_class(s[i]);
   }
 
-  return true;
+  return (classes & OAST_CC_BASE32HEX) != 0;
 }
 
 bool oast_is_valid_subdomain(const char *s, size_t len) {
+  return oast_simd_valid_subdomain(s, len);
+}
+
+bool oast_is_valid_subdomain_scalar(const char *s, size_t len) {
   // OAST subdomain format:
   // - 20 chars base32hex (preamble)
   // - 13+ chars z-base-32 (nonce)
+  return oast_shape_match(s, len, OAST_CID_LEN, OAST_NONCE_LEN,
+                          OAST_CC_ZBASE32);
+}
+
+bool oast_is_valid_subdomain_shape(const char *s, size_t len,
+                                   oast_shape_t shape) {
+  return oast_shape_match(s, len, shape.cid_len, shape.nonce_len,
+                          OAST_CC_ZBASE32);
+}
+
+// The default shape goes through the SIMD dispatch
+static bool valid_subdomain_default(const char *s, size_t len,
+                                    oast_shape_t shape) {
+  (void)shape;
+  return oast_is_valid_subdomain(s, len);
+}
+
+// Fixed-width kernels, one per OAST_SHAPE_KERNELS pair
+#define OAST_DEFINE_SUBDOMAIN_KERNEL(CID, NONCE)                               \
+  static bool valid_subdomain_##CID##_##NONCE(const char *s, size_t len,       \
+                                              oast_shape_t shape) {            \
+    (void)shape;                                                               \
+    return oast_shape_match(s, len, CID, NONCE, OAST_CC_ZBASE32);              \
+  }
+OAST_SHAPE_KERNELS(OAST_DEFINE_SUBDOMAIN_KERNEL)
+#undef OAST_DEFINE_SUBDOMAIN_KERNEL
+
+oast_subdomain_fn oast_subdomain_kernel(oast_shape_t shape) {
+  if (oast_shape_is_default(shape)) {
+    return valid_subdomain_default;
+  }
+#define OAST_PICK_SUBDOMAIN_KERNEL(CID, NONCE)                                 \
+  if (shape.cid_len == CID && shape.nonce_len == NONCE) {                      \
+    return valid_subdomain_##CID##_##NONCE;                                    \
+  }
+  OAST_SHAPE_KERNELS(OAST_PICK_SUBDOMAIN_KERNEL)
+#undef OAST_PICK_SUBDOMAIN_KERNEL
+  return oast_is_valid_subdomain_shape;
+}
 
-  if (len < 33) { // 20 + 13 minimum
+bool oast_validate_shape(const char *input, size_t input_len,
+                         oast_subdomain_fn kernel, oast_shape_t shape) {
+  const char *subdomain = NULL;
+  size_t subdomain_len = get_oast_subdomain(input, input_len, &subdomain);
+
+  if (subdomain_len == 0) {
     return false;
   }
+  return kernel(subdomain, subdomain_len, shape);
+}
 
-  // Check preamble (first 20 chars)
-  if (!oast_is_valid_preamble(s, 20)) {
+bool oast_validate(const char *input, size_t input_len) {
+  // One suffix lookup yields the subdomain; 0 means not a known OAST
+  // domain, or just the bare domain
+  const char *subdomain = NULL;
+  size_t subdomain_len = get_oast_subdomain(input, input_len, &subdomain);
+
+  if (subdomain_len == 0) {
     return false;
   }
 
-  // Check nonce (remaining chars)
-  for (size_t i = 20; i < len; i++) {
-    if (!is_zbase32_char(s[i])) {
-      return false;
+  // Validate subdomain structure
+  return oast_is_valid_subdomain(subdomain, subdomain_len);
+}
+
+bool oast_validate_level_parse(const char *s, size_t len,
+                               oast_validate_level_t *level) {
+  static const char *names[OAST_LEVEL_COUNT] = {"shape", "strict",
+                                                "plausible"};
+  for (int i = 0; i < OAST_LEVEL_COUNT; i++) {
+    if (strlen(names[i]) != len) {
+      continue;
+    }
+    size_t j = 0;
+    while (j < len && tolower((unsigned char)s[j]) == names[i][j]) {
+      j++;
+    }
+    if (j == len) {
+      *level = (oast_validate_level_t)i;
+      return true;
     }
   }
+  return false;
+}
 
-  return true;
+void oast_validate_ctx_init(oast_validate_ctx_t *ctx, oast_shape_t shape,
+                            uint32_t now) {
+  ctx->shape = shape;
+  ctx->subdomain = oast_subdomain_kernel(shape);
+  ctx->ts_min = OAST_PLAUSIBLE_TS_MIN;
+  ctx->ts_max = now > UINT32_MAX - OAST_PLAUSIBLE_TS_SKEW
+                    ? UINT32_MAX
+                    : now + OAST_PLAUSIBLE_TS_SKEW;
 }
 
-bool oast_validate(const char *input, size_t input_len) {
-  // Check if it's a known OAST domain (subdomain or FQDN)
-  const char *suffix = is_known_oast_domain(input, input_len);
-  if (!suffix) {
-    return false;
+bool oast_validate_level_shape(const char *input, size_t input_len,
+                               oast_shape_t shape) {
+  const char *subdomain = NULL;
+  size_t subdomain_len = get_oast_subdomain(input, input_len, &subdomain);
+  return subdomain_len >= (size_t)shape.cid_len + shape.nonce_len;
+}
+
+static bool level_shape(const char *input, size_t input_len,
+                        const oast_validate_ctx_t *ctx) {
+  return oast_validate_level_shape(input, input_len, ctx->shape);
+}
+
+// strict: oast_validate for the context's shape
+static bool level_strict(const char *input, size_t input_len,
+                         const oast_validate_ctx_t *ctx) {
+  return oast_validate_shape(input, input_len, ctx->subdomain, ctx->shape);
+}
+
+// A random nonce of n chars should use at least n / 3 distinct z-base-32
+// digits (capped at 8); runs such as "yyyyyyyyyyyyy" or "abababab..." fail
+static bool nonce_has_entropy(const char *nonce, size_t len) {
+  uint32_t seen = 0;
+  for (size_t i = 0; i < len; i++) {
+    seen |= 1u << (ZBASE32_VALUES[(unsigned char)nonce[i]] & 31);
   }
+  size_t needed = len / 3 < 8 ? len / 3 : 8;
+  return (size_t)oast_popcount32(seen) >= needed;
+}
 
-  // Extract subdomain
+// plausible: strict, then the decoded XID and nonce must look like
+// interactsh output. Fields a truncated correlation id does not cover are
+// not checked.
+static bool level_plausible(const char *input, size_t input_len,
+                            const oast_validate_ctx_t *ctx) {
   const char *subdomain = NULL;
   size_t subdomain_len = get_oast_subdomain(input, input_len, &subdomain);
+  if (subdomain_len == 0 ||
+      !ctx->subdomain(subdomain, subdomain_len, ctx->shape)) {
+    return false;
+  }
 
-  if (subdomain_len == 0) {
-    // Just a domain without subdomain, not valid
+  oast_decode_view_t view;
+  if (oast_decode_view_shape(subdomain, subdomain_len, ctx->shape, &view) !=
+      OAST_DECODE_OK) {
     return false;
   }
 
-  // Validate subdomain structure
-  return oast_is_valid_subdomain(subdomain, subdomain_len);
+  if (ctx->shape.cid_len >= OAST_CID_CHARS_TS) {
+    uint32_t ts = oast_xid_timestamp(&view.xid);
+    if (ts < ctx->ts_min || ts > ctx->ts_max) {
+      return false;
+    }
+  }
+  if (ctx->shape.cid_len >= OAST_CID_CHARS_COUNTER) {
+    uint32_t counter = oast_xid_counter(&view.xid);
+    if (counter == 0 || counter == 0xFFFFFF) {
+      return false;
+    }
+  }
+
+  return nonce_has_entropy(subdomain + view.nonce_off, view.nonce_len);
+}
+
+oast_level_fn oast_level_kernel(oast_validate_level_t level) {
+  switch (level) {
+  case OAST_LEVEL_SHAPE:
+    return level_shape;
+  case OAST_LEVEL_STRICT:
+    return level_strict;
+  case OAST_LEVEL_PLAUSIBLE:
+    return level_plausible;
+  default:
+    return NULL;
+  }
 }